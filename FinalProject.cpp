@@ -2,50 +2,1339 @@
 #include <GL/freeglut.h>
 #else
 #include <GL/glut.h>
+#ifdef FREEGLUT
+#include <GL/freeglut_ext.h>
+#endif
+#define EGL_NO_X11
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
 #endif
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <iostream>
 #include <string>
 
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/random.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/matrix_transform_2d.hpp>
+
 // Window Dimensions
 const int WIN_W = 1000;
 const int WIN_H = 750;
 constexpr float PI = 3.14159265358979323846f;
 
+// Scene Layout
+const float SAND_TOP_Y = WIN_H * 0.35f;
+const float OCEAN_TOP_Y = WIN_H * 0.5f;
+const float CELESTIAL_X = 180.0f;
+const float CELESTIAL_Y = 650.0f;
+const float CELESTIAL_R = 50.0f;
+
 // --- Global State ---
 static bool showCredits = true;
 static bool isNightMode = false;
 static float globalZoom = 1.0f;
 
+// Headless mode renders into an offscreen surface with no GLUT window
+static bool isHeadless = false;
+
+// Current window size, kept up to date by reshape()
+static int viewportW = WIN_W;
+static int viewportH = WIN_H;
+
+// --- CLOCK ---
+// All animation reads the scene clock, which is sampled once per frame.
+// RealTime follows the wall clock, FixedStep advances a constant amount per
+// frame and Scripted replays a list of frame times (holding the last one).
+enum class ClockMode { RealTime, FixedStep, Scripted };
+struct SceneClock {
+    ClockMode mode = ClockMode::RealTime;
+    float fixedStep = 1.0f / 60.0f;
+    std::vector<float> script;
+    long long frameIndex = 0;
+    float now = 0.0f;
+};
+static SceneClock sceneClock;
+static const auto realTimeStart = std::chrono::steady_clock::now();
+
+// --- SIMULATION STATE ---
+// Per-tick state is advanced on a fixed timestep so its speed does not
+// depend on the frame rate.
+const float SIM_DT = 1.0f / 60.0f;
+const float SIM_MAX_CATCHUP = 0.25f;
+static float simTime = 0.0f;
+static float simAccumulator = 0.0f;
+static float simLastFrameTime = -1.0f;
+static float prevGirlR = 0, prevGirlL = 0, prevBoyR = 0, prevBoyL = 0;
+
 // Umbrella global position
 static float umbX_global = 700.0f;
 static float umbY_global = 0.0f;
 
+// Axis-aligned box in scene units, for view culling
+struct Bounds {
+    float minX, minY, maxX, maxY;
+};
+
+// Box around count points, stride floats apart with x, y first
+Bounds pointBounds(const float* v, size_t count, int stride = 2) {
+    if (count == 0) return { 0.0f, 0.0f, 0.0f, 0.0f };
+    Bounds b = { v[0], v[1], v[0], v[1] };
+    for (size_t i = 1; i < count; ++i) {
+        const float* p = v + i * stride;
+        b.minX = std::min(b.minX, p[0]);
+        b.minY = std::min(b.minY, p[1]);
+        b.maxX = std::max(b.maxX, p[0]);
+        b.maxY = std::max(b.maxY, p[1]);
+    }
+    return b;
+}
+
 // --- NIGHT MODE ELEMENTS ---
-struct Point { float x, y; };
-std::vector<Point> stars;
+// Star field as structure-of-arrays: positions form one interleaved stream
+// for glVertexPointer, and the twinkle phase is kept as sin/cos so the
+// per-frame update is a multiply-add over flat arrays.
+struct StarField {
+    std::vector<float> positions;   // x, y interleaved
+    std::vector<float> phaseSin;
+    std::vector<float> phaseCos;
+    std::vector<GLubyte> colors;    // RGBA, alpha rewritten every frame
+    Bounds bounds = {};
+};
+StarField stars;
 
 // Shooting Star State
 static float sStarX = -100.0f, sStarY = -100.0f;
 static bool sStarActive = false;
 static float sStarNextSpawnTime = 0.0f;
+static float sStarSpawnDelay = 3.0f;
+static glm::uint64 sStarSpawnCount = 0;
+
+// Random content comes from glm's counter-based streams rather than rand():
+// value i of a stream depends only on its seed, so it can be generated from
+// any thread. Sand and clouds have fixed seeds and come out the same on every
+// platform; the sky only does under deterministic clocks (see initStars).
+static glm::uint64 skySeed = 1;
+const glm::uint64 SAND_SEED = 12345;
+const glm::uint64 CLOUD_SEED = 777;
 
 // --- VERTEX ARRAY STORAGE ---
 std::vector<float> treeTrunkVertices;
 std::vector<float> treeTrunkColors;
 std::vector<float> treeTrunkNormals;
+std::vector<float> smallTreeTrunkVertices;
+Bounds treeTrunkBounds = {};
+Bounds smallTreeTrunkBounds = {};
+
+// Palm fronds: rest pose plus a per-vertex sway direction. The sway only
+// depends on time and frond index, so each mesh is deformed once per frame
+// and shared by every tree of that size.
+const int FROND_COUNT = 6;
+struct FrondMesh {
+    std::vector<float> restVertices;
+    std::vector<float> swayDirs;
+    std::vector<float> vertices;
+    int vertsPerFrond = 0;
+    float swayAmplitude = 0.0f;
+    float lastT = -1.0f;
+    Bounds bounds = {};   // rest pose grown by the sway amplitude
+};
+FrondMesh largeFrondMesh;
+FrondMesh smallFrondMesh;
+
+// --- PRIMITIVE CACHE ---
+// Unit shapes (centered circle of radius 1, rect from (0,0) to (1,1)),
+// tessellated once per segment count and scaled into place when drawn.
+std::map<int, std::vector<float>> unitCircleCache;
+const float unitRectVertices[] = { 0, 0, 1, 0, 1, 1, 0, 1 };
+
+// Adaptive tessellation: circle segment counts come from the on-screen
+// radius and a maximum chord error, rounded up to a small set of LOD
+// buckets so the cache above stays small.
+static bool adaptiveTessellation = true;
+static float maxChordErrorPx = 0.25f;
+static float pixelsPerUnit = 1.0f;
+const int circleLodBuckets[] = { 8, 12, 16, 24, 32, 48, 64, 96, 128, 192, 256 };
+
+// --- CLOUDS ---
+// Cloud shapes are circles over a base rect, in units of the cloud's scale;
+// every shape fits inside the CLOUD_BOX rectangle. The first one is the
+// classic cloud. Clouds live on parallax layers, far to near, and wrap
+// around once they drift off screen.
+struct CloudPuff { float dx, dy, r; int segments; };
+struct CloudShape {
+    CloudPuff puffs[5];
+    float rectX, rectY, rectW, rectH;
+};
+const int CLOUD_SHAPES = 4;
+const CloudShape cloudShapes[CLOUD_SHAPES] = {
+    { { { 0, 0, 45, 50 }, { -55, -10, 40, 45 }, { 40, -15, 35, 45 }, { -35, -25, 25, 36 }, { 25, -28, 28, 36 } }, -60, -35, 120, 20 },
+    { { { 0, 5, 38, 48 }, { -48, -6, 32, 45 }, { 44, -8, 34, 45 }, { -78, -18, 18, 32 }, { 80, -20, 16, 32 } }, -90, -36, 176, 18 },
+    { { { 0, 10, 40, 48 }, { -35, -5, 30, 45 }, { 35, -5, 30, 45 }, { 0, -15, 28, 36 }, { -55, -20, 16, 32 } }, -60, -30, 110, 18 },
+    { { { -10, 15, 42, 48 }, { 30, 0, 36, 45 }, { -50, -5, 30, 45 }, { 60, -20, 22, 36 }, { -70, -22, 20, 36 } }, -85, -38, 165, 20 },
+};
+const float CLOUD_BOX_LEFT = -100.0f;
+const float CLOUD_BOX_BOTTOM = -62.5f;
+const float CLOUD_BOX_W = 200.0f;
+const float CLOUD_BOX_H = 125.0f;
+
+struct CloudLayer {
+    float speed, bobAmplitude, alpha;
+    float minScale, maxScale, minY, maxY;
+};
+const int CLOUD_LAYERS = 3;
+const CloudLayer cloudLayers[CLOUD_LAYERS] = {
+    { 2.5f, 2.0f, 0.55f, 0.35f, 0.55f, 600.0f, 730.0f },
+    { 5.0f, 3.0f, 0.8f, 0.6f, 0.85f, 580.0f, 710.0f },
+    { 8.0f, 5.0f, 1.0f, 0.9f, 1.3f, 590.0f, 690.0f },
+};
+
+struct Cloud {
+    float x, y, scale;
+    int shape;
+    int layer;
+};
+std::vector<Cloud> clouds;              // sorted far to near
+static int extraCloudCount = 0;
+
+// --- OCEAN ---
+// The ocean is a columns x rows grid from the horizon down to the shore,
+// displaced by a few octaves of travelling sine waves. Each octave keeps the
+// sin/cos of its spatial phase per vertex, pre-scaled by amplitude, so a new
+// frame costs one sin/cos pair per octave plus multiply-adds over flat arrays.
+const int OCEAN_MAX_OCTAVES = 4;
+const float oceanWaveLength[OCEAN_MAX_OCTAVES] = { 260.0f, 120.0f, 55.0f, 25.0f };
+const float oceanWaveAmplitude[OCEAN_MAX_OCTAVES] = { 3.0f, 1.8f, 0.9f, 0.45f };
+const float oceanWaveSpeed[OCEAN_MAX_OCTAVES] = { 0.6f, 1.1f, 1.9f, 3.1f };
+const float oceanRowPhase[OCEAN_MAX_OCTAVES] = { 1.3f, 2.1f, 0.7f, 2.9f };
+
+struct OceanSettings {
+    int columns = 96;
+    int rows = 4;
+    int octaves = 3;
+    bool crestLines = true;
+};
+static OceanSettings oceanSettings;
+
+struct OceanSurface {
+    OceanSettings built;
+    bool valid = false;
+    int vertexCount = 0;                 // (columns + 1) * (rows + 1), row-major
+    float amplitudeSum = 0.0f;
+    std::vector<float> baseX;
+    std::vector<float> baseY;
+    std::vector<float> basisSin;         // octaves x vertexCount
+    std::vector<float> basisCos;
+    std::vector<float> heights;
+    float lastT = -1.0f;
+
+    std::vector<float> stripVertices;    // all bands joined by degenerate triangles
+    std::vector<float> stripColors;
+    std::vector<float> crestVertices;    // GL_LINES along every row above the shore
+    std::vector<float> crestColors;
+};
+OceanSurface ocean;
+
+// --- SAND GRAIN LAYER ---
+// Baked once for a given sand height so the grains stay put between frames.
+const int SAND_GRAIN_COUNT = 1500;
+std::vector<float> sandGrainVertices;
+std::vector<float> sandGrainColorsDay;
+std::vector<float> sandGrainColorsNight;
+static float sandGrainTopY = -1.0f;
 
 // Get time in seconds
-float secs() {
+float realSecs() {
+    if (isHeadless) return std::chrono::duration<float>(std::chrono::steady_clock::now() - realTimeStart).count();
     return glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
 }
 
+// Sample the scene clock for a new frame
+void tickClock() {
+    switch (sceneClock.mode) {
+    case ClockMode::RealTime:
+        sceneClock.now = realSecs();
+        break;
+    case ClockMode::FixedStep:
+        sceneClock.now = sceneClock.frameIndex * sceneClock.fixedStep;
+        break;
+    case ClockMode::Scripted:
+        if (!sceneClock.script.empty()) {
+            size_t i = std::min((size_t)sceneClock.frameIndex, sceneClock.script.size() - 1);
+            sceneClock.now = sceneClock.script[i];
+        }
+        break;
+    }
+    sceneClock.frameIndex++;
+}
+
+// Get time in seconds
+float secs() {
+    return sceneClock.now;
+}
+
+// ----------------- GL Extensions -----------------
+// Entry points past GL 1.1 are looked up at runtime so the fixed-function
+// path still builds against the plain opengl32 headers on Windows.
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT 0x8866
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+#ifndef GL_TIMESTAMP
+#define GL_TIMESTAMP 0x8E28
+#endif
+#ifndef GL_FRAMEBUFFER
+#define GL_FRAMEBUFFER 0x8D40
+#define GL_COLOR_ATTACHMENT0 0x8CE0
+#define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#endif
+#ifndef GL_FRAMEBUFFER_BINDING
+#define GL_FRAMEBUFFER_BINDING 0x8CA6
+#endif
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+#ifndef GL_NUM_EXTENSIONS
+#define GL_NUM_EXTENSIONS 0x821D
+#endif
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#define GL_STREAM_DRAW 0x88E0
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#define GL_VERTEX_SHADER 0x8B31
+#define GL_COMPILE_STATUS 0x8B81
+#define GL_LINK_STATUS 0x8B82
+#define GL_INFO_LOG_LENGTH 0x8B84
+#endif
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+
+typedef void (APIENTRY* GenQueriesProc)(GLsizei n, GLuint* ids);
+typedef void (APIENTRY* QueryCounterProc)(GLuint id, GLenum target);
+typedef void (APIENTRY* GetQueryObjectivProc)(GLuint id, GLenum pname, GLint* params);
+typedef void (APIENTRY* GetQueryObjectui64vProc)(GLuint id, GLenum pname, unsigned long long* params);
+typedef int (APIENTRY* SwapIntervalProc)(int interval);
+typedef void (APIENTRY* GenFramebuffersProc)(GLsizei n, GLuint* ids);
+typedef void (APIENTRY* DeleteFramebuffersProc)(GLsizei n, const GLuint* ids);
+typedef void (APIENTRY* BindFramebufferProc)(GLenum target, GLuint framebuffer);
+typedef void (APIENTRY* FramebufferTexture2DProc)(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+typedef GLenum (APIENTRY* CheckFramebufferStatusProc)(GLenum target);
+typedef const GLubyte* (APIENTRY* GetStringiProc)(GLenum name, GLuint index);
+
+// Core profile entry points; sync objects are passed around as void*
+typedef void (APIENTRY* GenVertexArraysProc)(GLsizei n, GLuint* arrays);
+typedef void (APIENTRY* BindVertexArrayProc)(GLuint array);
+typedef void (APIENTRY* GenBuffersProc)(GLsizei n, GLuint* buffers);
+typedef void (APIENTRY* BindBufferProc)(GLenum target, GLuint buffer);
+typedef void (APIENTRY* BufferDataProc)(GLenum target, ptrdiff_t size, const void* data, GLenum usage);
+typedef void (APIENTRY* BufferSubDataProc)(GLenum target, ptrdiff_t offset, ptrdiff_t size, const void* data);
+typedef void (APIENTRY* BufferStorageProc)(GLenum target, ptrdiff_t size, const void* data, GLbitfield flags);
+typedef void* (APIENTRY* MapBufferRangeProc)(GLenum target, ptrdiff_t offset, ptrdiff_t length, GLbitfield access);
+typedef void (APIENTRY* EnableVertexAttribArrayProc)(GLuint index);
+typedef void (APIENTRY* DisableVertexAttribArrayProc)(GLuint index);
+typedef void (APIENTRY* VertexAttribPointerProc)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+typedef void (APIENTRY* VertexAttrib4fProc)(GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+typedef GLuint (APIENTRY* CreateShaderProc)(GLenum type);
+typedef void (APIENTRY* ShaderSourceProc)(GLuint shader, GLsizei count, const char* const* source, const GLint* length);
+typedef void (APIENTRY* CompileShaderProc)(GLuint shader);
+typedef void (APIENTRY* GetShaderivProc)(GLuint shader, GLenum pname, GLint* params);
+typedef void (APIENTRY* GetShaderInfoLogProc)(GLuint shader, GLsizei bufSize, GLsizei* length, char* infoLog);
+typedef void (APIENTRY* DeleteShaderProc)(GLuint shader);
+typedef GLuint (APIENTRY* CreateProgramProc)();
+typedef void (APIENTRY* AttachShaderProc)(GLuint program, GLuint shader);
+typedef void (APIENTRY* LinkProgramProc)(GLuint program);
+typedef void (APIENTRY* GetProgramivProc)(GLuint program, GLenum pname, GLint* params);
+typedef void (APIENTRY* GetProgramInfoLogProc)(GLuint program, GLsizei bufSize, GLsizei* length, char* infoLog);
+typedef void (APIENTRY* UseProgramProc)(GLuint program);
+typedef GLint (APIENTRY* GetUniformLocationProc)(GLuint program, const char* name);
+typedef void (APIENTRY* Uniform1iProc)(GLint location, GLint v0);
+typedef void (APIENTRY* Uniform1fProc)(GLint location, GLfloat v0);
+typedef void (APIENTRY* Uniform4fvProc)(GLint location, GLsizei count, const GLfloat* value);
+typedef void (APIENTRY* UniformMatrix3fvProc)(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+typedef void (APIENTRY* UniformMatrix4fvProc)(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+typedef void (APIENTRY* DrawArraysInstancedProc)(GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+typedef void (APIENTRY* VertexAttribDivisorProc)(GLuint index, GLuint divisor);
+typedef void* (APIENTRY* FenceSyncProc)(GLenum condition, GLbitfield flags);
+typedef GLenum (APIENTRY* ClientWaitSyncProc)(void* sync, GLbitfield flags, unsigned long long timeout);
+typedef void (APIENTRY* DeleteSyncProc)(void* sync);
+
+struct GLExtensions {
+    bool timerQuery = false;
+    GenQueriesProc genQueries = nullptr;
+    QueryCounterProc queryCounter = nullptr;
+    GetQueryObjectivProc getQueryObjectiv = nullptr;
+    GetQueryObjectui64vProc getQueryObjectui64v = nullptr;
+    SwapIntervalProc swapInterval = nullptr;
+
+    bool framebufferObject = false;
+    GenFramebuffersProc genFramebuffers = nullptr;
+    DeleteFramebuffersProc deleteFramebuffers = nullptr;
+    BindFramebufferProc bindFramebuffer = nullptr;
+    FramebufferTexture2DProc framebufferTexture2D = nullptr;
+    CheckFramebufferStatusProc checkFramebufferStatus = nullptr;
+
+    GetStringiProc getStringi = nullptr;
+
+    bool coreProfile = false;
+    GenVertexArraysProc genVertexArrays = nullptr;
+    BindVertexArrayProc bindVertexArray = nullptr;
+    GenBuffersProc genBuffers = nullptr;
+    BindBufferProc bindBuffer = nullptr;
+    BufferDataProc bufferData = nullptr;
+    BufferSubDataProc bufferSubData = nullptr;
+    MapBufferRangeProc mapBufferRange = nullptr;
+    EnableVertexAttribArrayProc enableVertexAttribArray = nullptr;
+    DisableVertexAttribArrayProc disableVertexAttribArray = nullptr;
+    VertexAttribPointerProc vertexAttribPointer = nullptr;
+    VertexAttrib4fProc vertexAttrib4f = nullptr;
+    CreateShaderProc createShader = nullptr;
+    ShaderSourceProc shaderSource = nullptr;
+    CompileShaderProc compileShader = nullptr;
+    GetShaderivProc getShaderiv = nullptr;
+    GetShaderInfoLogProc getShaderInfoLog = nullptr;
+    DeleteShaderProc deleteShader = nullptr;
+    CreateProgramProc createProgram = nullptr;
+    AttachShaderProc attachShader = nullptr;
+    LinkProgramProc linkProgram = nullptr;
+    GetProgramivProc getProgramiv = nullptr;
+    GetProgramInfoLogProc getProgramInfoLog = nullptr;
+    UseProgramProc useProgram = nullptr;
+    GetUniformLocationProc getUniformLocation = nullptr;
+    Uniform1iProc uniform1i = nullptr;
+    Uniform1fProc uniform1f = nullptr;
+    Uniform4fvProc uniform4fv = nullptr;
+    UniformMatrix3fvProc uniformMatrix3fv = nullptr;
+    UniformMatrix4fvProc uniformMatrix4fv = nullptr;
+    DrawArraysInstancedProc drawArraysInstanced = nullptr;
+    VertexAttribDivisorProc vertexAttribDivisor = nullptr;
+    FenceSyncProc fenceSync = nullptr;
+    ClientWaitSyncProc clientWaitSync = nullptr;
+    DeleteSyncProc deleteSync = nullptr;
+
+    // Persistent mapped buffers (GL 4.4 or ARB_buffer_storage)
+    bool bufferStorageSupported = false;
+    BufferStorageProc bufferStorage = nullptr;
+};
+static GLExtensions glExt;
+
+void* getGLProcAddress(const char* name) {
+#ifndef _WIN32
+    if (isHeadless) return (void*)eglGetProcAddress(name);
+#endif
+#ifdef FREEGLUT
+    return (void*)glutGetProcAddress(name);
+#else
+    return nullptr;
+#endif
+}
+
+bool hasGLVersion(int major, int minor) {
+    const char* version = (const char*)glGetString(GL_VERSION);
+    int glMajor = 0, glMinor = 0;
+    if (!version || sscanf(version, "%d.%d", &glMajor, &glMinor) != 2) return false;
+    return glMajor > major || (glMajor == major && glMinor >= minor);
+}
+
+bool hasGLExtension(const char* name) {
+    // Core profiles drop the single extension string
+    if (glExt.getStringi) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i) {
+            const char* extension = (const char*)glExt.getStringi(GL_EXTENSIONS, i);
+            if (extension && strcmp(extension, name) == 0) return true;
+        }
+        return false;
+    }
+    const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+    return extensions && strstr(extensions, name) != nullptr;
+}
+
+template <typename Proc>
+bool loadGLProc(Proc& proc, const char* name) {
+    proc = (Proc)getGLProcAddress(name);
+    return proc != nullptr;
+}
+
+void loadGLExtensions() {
+    if (hasGLVersion(3, 0)) glExt.getStringi = (GetStringiProc)getGLProcAddress("glGetStringi");
+    if (hasGLVersion(3, 3) || hasGLExtension("GL_ARB_timer_query")) {
+        glExt.genQueries = (GenQueriesProc)getGLProcAddress("glGenQueries");
+        glExt.queryCounter = (QueryCounterProc)getGLProcAddress("glQueryCounter");
+        glExt.getQueryObjectiv = (GetQueryObjectivProc)getGLProcAddress("glGetQueryObjectiv");
+        glExt.getQueryObjectui64v = (GetQueryObjectui64vProc)getGLProcAddress("glGetQueryObjectui64v");
+        glExt.timerQuery = glExt.genQueries && glExt.queryCounter && glExt.getQueryObjectiv && glExt.getQueryObjectui64v;
+    }
+    // Core names from GL 3.0, otherwise the EXT entry points with the same signatures
+    const char* fboSuffix = hasGLVersion(3, 0) ? "" : (hasGLExtension("GL_EXT_framebuffer_object") ? "EXT" : nullptr);
+    if (fboSuffix) {
+        std::string suffix = fboSuffix;
+        glExt.genFramebuffers = (GenFramebuffersProc)getGLProcAddress(("glGenFramebuffers" + suffix).c_str());
+        glExt.deleteFramebuffers = (DeleteFramebuffersProc)getGLProcAddress(("glDeleteFramebuffers" + suffix).c_str());
+        glExt.bindFramebuffer = (BindFramebufferProc)getGLProcAddress(("glBindFramebuffer" + suffix).c_str());
+        glExt.framebufferTexture2D = (FramebufferTexture2DProc)getGLProcAddress(("glFramebufferTexture2D" + suffix).c_str());
+        glExt.checkFramebufferStatus = (CheckFramebufferStatusProc)getGLProcAddress(("glCheckFramebufferStatus" + suffix).c_str());
+        glExt.framebufferObject = glExt.genFramebuffers && glExt.deleteFramebuffers && glExt.bindFramebuffer
+            && glExt.framebufferTexture2D && glExt.checkFramebufferStatus;
+    }
+    if (hasGLVersion(3, 3)) {
+        bool ok = true;
+        ok &= loadGLProc(glExt.genVertexArrays, "glGenVertexArrays");
+        ok &= loadGLProc(glExt.bindVertexArray, "glBindVertexArray");
+        ok &= loadGLProc(glExt.genBuffers, "glGenBuffers");
+        ok &= loadGLProc(glExt.bindBuffer, "glBindBuffer");
+        ok &= loadGLProc(glExt.bufferData, "glBufferData");
+        ok &= loadGLProc(glExt.bufferSubData, "glBufferSubData");
+        ok &= loadGLProc(glExt.mapBufferRange, "glMapBufferRange");
+        ok &= loadGLProc(glExt.enableVertexAttribArray, "glEnableVertexAttribArray");
+        ok &= loadGLProc(glExt.disableVertexAttribArray, "glDisableVertexAttribArray");
+        ok &= loadGLProc(glExt.vertexAttribPointer, "glVertexAttribPointer");
+        ok &= loadGLProc(glExt.vertexAttrib4f, "glVertexAttrib4f");
+        ok &= loadGLProc(glExt.createShader, "glCreateShader");
+        ok &= loadGLProc(glExt.shaderSource, "glShaderSource");
+        ok &= loadGLProc(glExt.compileShader, "glCompileShader");
+        ok &= loadGLProc(glExt.getShaderiv, "glGetShaderiv");
+        ok &= loadGLProc(glExt.getShaderInfoLog, "glGetShaderInfoLog");
+        ok &= loadGLProc(glExt.deleteShader, "glDeleteShader");
+        ok &= loadGLProc(glExt.createProgram, "glCreateProgram");
+        ok &= loadGLProc(glExt.attachShader, "glAttachShader");
+        ok &= loadGLProc(glExt.linkProgram, "glLinkProgram");
+        ok &= loadGLProc(glExt.getProgramiv, "glGetProgramiv");
+        ok &= loadGLProc(glExt.getProgramInfoLog, "glGetProgramInfoLog");
+        ok &= loadGLProc(glExt.useProgram, "glUseProgram");
+        ok &= loadGLProc(glExt.getUniformLocation, "glGetUniformLocation");
+        ok &= loadGLProc(glExt.uniform1i, "glUniform1i");
+        ok &= loadGLProc(glExt.uniform1f, "glUniform1f");
+        ok &= loadGLProc(glExt.uniform4fv, "glUniform4fv");
+        ok &= loadGLProc(glExt.uniformMatrix3fv, "glUniformMatrix3fv");
+        ok &= loadGLProc(glExt.uniformMatrix4fv, "glUniformMatrix4fv");
+        ok &= loadGLProc(glExt.drawArraysInstanced, "glDrawArraysInstanced");
+        ok &= loadGLProc(glExt.vertexAttribDivisor, "glVertexAttribDivisor");
+        ok &= loadGLProc(glExt.fenceSync, "glFenceSync");
+        ok &= loadGLProc(glExt.clientWaitSync, "glClientWaitSync");
+        ok &= loadGLProc(glExt.deleteSync, "glDeleteSync");
+        glExt.coreProfile = ok;
+    }
+    if (glExt.coreProfile && (hasGLVersion(4, 4) || hasGLExtension("GL_ARB_buffer_storage"))) {
+        glExt.bufferStorageSupported = loadGLProc(glExt.bufferStorage, "glBufferStorage");
+    }
+    if (!isHeadless) {
+#ifdef _WIN32
+        glExt.swapInterval = (SwapIntervalProc)getGLProcAddress("wglSwapIntervalEXT");
+#else
+        glExt.swapInterval = (SwapIntervalProc)getGLProcAddress("glXSwapIntervalMESA");
+        if (!glExt.swapInterval) glExt.swapInterval = (SwapIntervalProc)getGLProcAddress("glXSwapIntervalSGI");
+#endif
+    }
+}
+
+// ----------------- Renderer -----------------
+// Scene code draws through gfx rather than calling GL directly. The legacy
+// backend forwards to the fixed-function pipeline. The core backend runs on a
+// GL 3.3 core profile context with one VAO, a streamed vertex buffer and three
+// small shaders (flat colour, lit, textured), and emulates what the scene
+// uses from the old pipeline: the matrix stacks, glBegin/glEnd, GL_QUADS and
+// GL_POLYGON, GL_LIGHT0 with colour material, and the alpha test.
+enum class RendererBackend { Legacy, Core };
+static RendererBackend rendererBackend = RendererBackend::Legacy;
+static bool elideRedundantState = true;
+
+// Client-side streams for Renderer::drawArrays. A missing colour or normal
+// stream uses the current colour/normal, like a disabled client array.
+struct VertexArrays {
+    const float* positions = nullptr;
+    int positionSize = 2;
+    const void* colors = nullptr;
+    int colorSize = 4;
+    GLenum colorType = GL_FLOAT;
+    const float* normals = nullptr;
+    const float* texCoords = nullptr;
+};
+
+// A textured screen-aligned quad; the texel is multiplied by the tint
+struct SpriteInstance {
+    float x, y, w, h;
+    float u0, v0, u1, v1;
+    float r, g, b, a;
+};
+
+// Shadow of the pipeline state the scene toggles. Starts at the GL defaults
+// and is only correct while every change goes through the Renderer.
+struct RenderState {
+    bool lighting = false;
+    bool blend = false;
+    GLenum blendSrc = GL_ONE;
+    GLenum blendDst = GL_ZERO;
+    float lineWidth = 1.0f;
+    float pointSize = 1.0f;
+    GLuint texture = 0;
+    bool alphaTest = false;
+    float alphaRef = 0.0f;
+};
+
+struct StateStats {
+    int applied = 0;
+    int elided = 0;
+};
+
+class Renderer {
+public:
+    virtual ~Renderer() {}
+    virtual bool init() = 0;
+    virtual void beginFrame() {}
+    virtual void endFrame() {}
+
+    // Projection is a 2D ortho box; the modelview stack works in the XY plane
+    virtual void setProjection(float left, float right, float bottom, float top) = 0;
+    virtual void pushProjection() = 0;
+    virtual void popProjection() = 0;
+    virtual void loadIdentity() = 0;
+    virtual void pushMatrix() = 0;
+    virtual void popMatrix() = 0;
+    virtual void translate(float x, float y) = 0;
+    virtual void rotate(float degrees) = 0;
+    virtual void scale(float x, float y) = 0;
+
+    virtual void begin(GLenum mode) = 0;
+    virtual void end() = 0;
+    virtual void vertex2f(float x, float y) = 0;
+    virtual void color4f(float r, float g, float b, float a) = 0;
+    void color3f(float r, float g, float b) { color4f(r, g, b, 1.0f); }
+    virtual void normal3f(float x, float y, float z) = 0;
+    virtual void drawArrays(GLenum mode, int count, const VertexArrays& arrays) = 0;
+    // One draw for the whole batch, unlit
+    virtual void drawSprites(GLuint texture, const SpriteInstance* sprites, int count) = 0;
+
+    virtual void setLight(const float position[4], const float diffuse[4]) = 0;
+    virtual void enableColorMaterial() = 0;
+    virtual void drawBitmapText(float x, float y, void* font, const std::string& text) = 0;
+
+    // Tracked state: a request matching the shadow copy never reaches GL
+    void setLighting(bool on) {
+        if (!stateChanged(state.lighting == on)) return;
+        state.lighting = on;
+        applyLighting(on);
+    }
+    // Non-zero binds a 2D texture whose texels replace the vertex colour
+    void setTexture(GLuint texture) {
+        if (!stateChanged(state.texture == texture)) return;
+        state.texture = texture;
+        applyTexture(texture);
+    }
+    void setAlphaTest(bool on, float ref) {
+        if (!stateChanged(state.alphaTest == on && (!on || state.alphaRef == ref))) return;
+        state.alphaTest = on;
+        state.alphaRef = ref;
+        applyAlphaTest(on, ref);
+    }
+    // These mean the same thing in both profiles
+    void setBlend(bool on) {
+        if (!stateChanged(state.blend == on)) return;
+        state.blend = on;
+        if (on) glEnable(GL_BLEND); else glDisable(GL_BLEND);
+    }
+    void blendFunc(GLenum src, GLenum dst) {
+        if (!stateChanged(state.blendSrc == src && state.blendDst == dst)) return;
+        state.blendSrc = src;
+        state.blendDst = dst;
+        glBlendFunc(src, dst);
+    }
+    void lineWidth(float width) {
+        if (!stateChanged(state.lineWidth == width)) return;
+        state.lineWidth = width;
+        glLineWidth(width);
+    }
+    void pointSize(float size) {
+        if (!stateChanged(state.pointSize == size)) return;
+        state.pointSize = size;
+        glPointSize(size);
+    }
+
+    bool blending() const { return state.blend; }
+    bool lightingEnabled() const { return state.lighting; }
+    const glm::vec4& currentColor() const { return color; }
+    const StateStats& stateStats() const { return stats; }
+    void resetStateStats() { stats = StateStats(); }
+
+protected:
+    virtual void applyLighting(bool on) = 0;
+    virtual void applyTexture(GLuint texture) = 0;
+    virtual void applyAlphaTest(bool on, float ref) = 0;
+
+    bool stateChanged(bool same) {
+        if (same && elideRedundantState) {
+            stats.elided++;
+            return false;
+        }
+        stats.applied++;
+        return true;
+    }
+
+    RenderState state;
+    StateStats stats;
+    glm::vec4 color = glm::vec4(1.0f);
+};
+
+class LegacyRenderer : public Renderer {
+public:
+    bool init() override {
+        glEnable(GL_LIGHT0);
+        glEnable(GL_NORMALIZE);
+        return true;
+    }
+
+    void setProjection(float left, float right, float bottom, float top) override {
+        glMatrixMode(GL_PROJECTION);
+        glLoadIdentity();
+        gluOrtho2D(left, right, bottom, top);
+        glMatrixMode(GL_MODELVIEW);
+    }
+    void pushProjection() override {
+        glMatrixMode(GL_PROJECTION);
+        glPushMatrix();
+        glMatrixMode(GL_MODELVIEW);
+    }
+    void popProjection() override {
+        glMatrixMode(GL_PROJECTION);
+        glPopMatrix();
+        glMatrixMode(GL_MODELVIEW);
+    }
+    void loadIdentity() override { glLoadIdentity(); }
+    void pushMatrix() override { glPushMatrix(); }
+    void popMatrix() override { glPopMatrix(); }
+    void translate(float x, float y) override { glTranslatef(x, y, 0.0f); }
+    void rotate(float degrees) override { glRotatef(degrees, 0.0f, 0.0f, 1.0f); }
+    void scale(float x, float y) override { glScalef(x, y, 1.0f); }
+
+    void begin(GLenum mode) override { glBegin(mode); }
+    void end() override { glEnd(); }
+    void vertex2f(float x, float y) override { glVertex2f(x, y); }
+    void color4f(float r, float g, float b, float a) override {
+        color = glm::vec4(r, g, b, a);
+        glColor4f(r, g, b, a);
+    }
+    void normal3f(float x, float y, float z) override { glNormal3f(x, y, z); }
+
+    void drawArrays(GLenum mode, int count, const VertexArrays& arrays) override {
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glVertexPointer(arrays.positionSize, GL_FLOAT, 0, arrays.positions);
+        if (arrays.colors) {
+            glEnableClientState(GL_COLOR_ARRAY);
+            glColorPointer(arrays.colorSize, arrays.colorType, 0, arrays.colors);
+        }
+        if (arrays.normals) {
+            glEnableClientState(GL_NORMAL_ARRAY);
+            glNormalPointer(GL_FLOAT, 0, arrays.normals);
+        }
+        if (arrays.texCoords) {
+            glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+            glTexCoordPointer(2, GL_FLOAT, 0, arrays.texCoords);
+        }
+        glDrawArrays(mode, 0, count);
+        if (arrays.texCoords) glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        if (arrays.normals) glDisableClientState(GL_NORMAL_ARRAY);
+        if (arrays.colors) glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+    }
+
+    // No instancing here, so the batch is expanded into one quad array
+    void drawSprites(GLuint texture, const SpriteInstance* sprites, int count) override {
+        spriteVertices.resize(count * 8);
+        spriteTexCoords.resize(count * 8);
+        spriteColors.resize(count * 16);
+        for (int i = 0; i < count; ++i) {
+            const SpriteInstance& sp = sprites[i];
+            float* v = &spriteVertices[i * 8];
+            float* uv = &spriteTexCoords[i * 8];
+            float* c = &spriteColors[i * 16];
+            v[0] = sp.x;        v[1] = sp.y;        uv[0] = sp.u0; uv[1] = sp.v0;
+            v[2] = sp.x + sp.w; v[3] = sp.y;        uv[2] = sp.u1; uv[3] = sp.v0;
+            v[4] = sp.x + sp.w; v[5] = sp.y + sp.h; uv[4] = sp.u1; uv[5] = sp.v1;
+            v[6] = sp.x;        v[7] = sp.y + sp.h; uv[6] = sp.u0; uv[7] = sp.v1;
+            for (int k = 0; k < 4; ++k) {
+                c[k * 4 + 0] = sp.r;
+                c[k * 4 + 1] = sp.g;
+                c[k * 4 + 2] = sp.b;
+                c[k * 4 + 3] = sp.a;
+            }
+        }
+        glEnable(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+        VertexArrays arrays;
+        arrays.positions = spriteVertices.data();
+        arrays.colors = spriteColors.data();
+        arrays.texCoords = spriteTexCoords.data();
+        drawArrays(GL_QUADS, count * 4, arrays);
+        // Put back whatever the tracked texture state says
+        if (state.texture) applyTexture(state.texture);
+        else {
+            glBindTexture(GL_TEXTURE_2D, 0);
+            glDisable(GL_TEXTURE_2D);
+        }
+    }
+
+    void setLight(const float position[4], const float diffuse[4]) override {
+        glLightfv(GL_LIGHT0, GL_POSITION, position);
+        glLightfv(GL_LIGHT0, GL_DIFFUSE, diffuse);
+    }
+    void enableColorMaterial() override {
+        glEnable(GL_COLOR_MATERIAL);
+        glColorMaterial(GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
+    }
+    void drawBitmapText(float x, float y, void* font, const std::string& text) override {
+        glRasterPos2f(x, y);
+        for (char c : text) glutBitmapCharacter(font, c);
+    }
+
+protected:
+    void applyLighting(bool on) override {
+        if (on) glEnable(GL_LIGHTING);
+        else glDisable(GL_LIGHTING);
+    }
+    void applyTexture(GLuint texture) override {
+        if (texture) {
+            glEnable(GL_TEXTURE_2D);
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+        }
+        else {
+            glBindTexture(GL_TEXTURE_2D, 0);
+            glDisable(GL_TEXTURE_2D);
+        }
+    }
+    void applyAlphaTest(bool on, float ref) override {
+        if (on) {
+            glEnable(GL_ALPHA_TEST);
+            glAlphaFunc(GL_GREATER, ref);
+        }
+        else glDisable(GL_ALPHA_TEST);
+    }
+
+private:
+    std::vector<float> spriteVertices;
+    std::vector<float> spriteTexCoords;
+    std::vector<float> spriteColors;
+};
+
+// Per-vertex lighting matches the fixed-function setup the scene uses:
+// colour material on ambient and diffuse, the default 0.2 global ambient,
+// and a single positional light with no ambient or specular term.
+const char* CORE_VERTEX_SHADER_FLAT = R"(#version 330 core
+layout(location = 0) in vec4 aPosition;
+layout(location = 1) in vec4 aColor;
+uniform mat4 uMvp;
+out vec4 vColor;
+void main() {
+    gl_Position = uMvp * aPosition;
+    vColor = aColor;
+}
+)";
+
+const char* CORE_VERTEX_SHADER_LIT = R"(#version 330 core
+layout(location = 0) in vec4 aPosition;
+layout(location = 1) in vec4 aColor;
+layout(location = 2) in vec3 aNormal;
+uniform mat4 uMvp;
+uniform mat4 uModelView;
+uniform mat3 uNormalMatrix;
+uniform vec4 uLightPosition;
+uniform vec4 uLightDiffuse;
+uniform vec4 uAmbient;
+out vec4 vColor;
+void main() {
+    gl_Position = uMvp * aPosition;
+    vec3 eye = (uModelView * aPosition).xyz;
+    vec3 n = normalize(uNormalMatrix * aNormal);
+    vec3 l = normalize(uLightPosition.xyz - eye * uLightPosition.w);
+    vec3 rgb = aColor.rgb * (uAmbient.rgb + uLightDiffuse.rgb * max(dot(n, l), 0.0));
+    vColor = vec4(clamp(rgb, 0.0, 1.0), aColor.a);
+}
+)";
+
+const char* CORE_FRAGMENT_SHADER_COLOR = R"(#version 330 core
+in vec4 vColor;
+out vec4 fragColor;
+void main() {
+    fragColor = vColor;
+}
+)";
+
+const char* CORE_VERTEX_SHADER_TEXTURED = R"(#version 330 core
+layout(location = 0) in vec4 aPosition;
+layout(location = 3) in vec2 aTexCoord;
+uniform mat4 uMvp;
+out vec2 vTexCoord;
+void main() {
+    gl_Position = uMvp * aPosition;
+    vTexCoord = aTexCoord;
+}
+)";
+
+// uAlphaRef below zero disables the alpha test
+const char* CORE_FRAGMENT_SHADER_TEXTURED = R"(#version 330 core
+in vec2 vTexCoord;
+uniform sampler2D uTexture;
+uniform float uAlphaRef;
+out vec4 fragColor;
+void main() {
+    vec4 texel = texture(uTexture, vTexCoord);
+    if (texel.a <= uAlphaRef) discard;
+    fragColor = texel;
+}
+)";
+
+// Sprites are instanced: the corner comes from gl_VertexID of a 4-vertex strip
+const char* CORE_VERTEX_SHADER_SPRITE = R"(#version 330 core
+layout(location = 4) in vec4 aRect;
+layout(location = 5) in vec4 aTexRect;
+layout(location = 6) in vec4 aTint;
+uniform mat4 uMvp;
+out vec2 vTexCoord;
+out vec4 vTint;
+void main() {
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    gl_Position = uMvp * vec4(aRect.xy + corner * aRect.zw, 0.0, 1.0);
+    vTexCoord = mix(aTexRect.xy, aTexRect.zw, corner);
+    vTint = aTint;
+}
+)";
+
+const char* CORE_FRAGMENT_SHADER_SPRITE = R"(#version 330 core
+in vec2 vTexCoord;
+in vec4 vTint;
+uniform sampler2D uTexture;
+out vec4 fragColor;
+void main() {
+    fragColor = texture(uTexture, vTexCoord) * vTint;
+}
+)";
+
+class CoreRenderer : public Renderer {
+public:
+    bool init() override {
+        if (!glExt.coreProfile) {
+            std::cerr << "Core renderer: GL 3.3 entry points are missing" << std::endl;
+            return false;
+        }
+        if (!buildProgram(flat, CORE_VERTEX_SHADER_FLAT, CORE_FRAGMENT_SHADER_COLOR)
+            || !buildProgram(lit, CORE_VERTEX_SHADER_LIT, CORE_FRAGMENT_SHADER_COLOR)
+            || !buildProgram(textured, CORE_VERTEX_SHADER_TEXTURED, CORE_FRAGMENT_SHADER_TEXTURED)
+            || !buildProgram(sprite, CORE_VERTEX_SHADER_SPRITE, CORE_FRAGMENT_SHADER_SPRITE)) return false;
+        glExt.useProgram(textured.id);
+        glExt.uniform1i(textured.texture, 0);
+        glExt.useProgram(sprite.id);
+        glExt.uniform1i(sprite.texture, 0);
+        glExt.useProgram(0);
+
+        glExt.genVertexArrays(1, &vao);
+        glExt.bindVertexArray(vao);
+        glExt.genBuffers(1, &quadIndexBuffer);
+        glExt.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadIndexBuffer);
+
+        // Persistent mapping lets each frame write straight into its own
+        // segment; without it the buffer is orphaned every frame instead
+        glExt.genBuffers(1, &streamBuffer);
+        glExt.bindBuffer(GL_ARRAY_BUFFER, streamBuffer);
+        if (glExt.bufferStorageSupported) {
+            GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glExt.bufferStorage(GL_ARRAY_BUFFER, STREAM_SEGMENT_BYTES * STREAM_SEGMENTS, nullptr, flags);
+            streamMapped = (unsigned char*)glExt.mapBufferRange(GL_ARRAY_BUFFER, 0, STREAM_SEGMENT_BYTES * STREAM_SEGMENTS, flags);
+        }
+        if (!streamMapped) glExt.bufferData(GL_ARRAY_BUFFER, STREAM_SEGMENT_BYTES, nullptr, GL_STREAM_DRAW);
+        std::cout << "Core renderer: " << (streamMapped ? "persistent mapped" : "orphaned") << " stream buffer" << std::endl;
+        return true;
+    }
+
+    void beginFrame() override {
+        if (streamMapped) {
+            streamSegment = (streamSegment + 1) % STREAM_SEGMENTS;
+            if (streamFences[streamSegment]) {
+                glExt.clientWaitSync(streamFences[streamSegment], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ULL);
+                glExt.deleteSync(streamFences[streamSegment]);
+                streamFences[streamSegment] = nullptr;
+            }
+        }
+        else glExt.bufferData(GL_ARRAY_BUFFER, STREAM_SEGMENT_BYTES, nullptr, GL_STREAM_DRAW);
+        streamHead = 0;
+    }
+
+    void endFrame() override {
+        if (streamMapped && !streamFences[streamSegment]) {
+            streamFences[streamSegment] = glExt.fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+    }
+
+    void setProjection(float left, float right, float bottom, float top) override {
+        projection = glm::ortho(left, right, bottom, top, -1.0f, 1.0f);
+    }
+    void pushProjection() override { projectionStack.push_back(projection); }
+    void popProjection() override {
+        if (projectionStack.empty()) return;
+        projection = projectionStack.back();
+        projectionStack.pop_back();
+    }
+    void loadIdentity() override { modelView = glm::mat4(1.0f); }
+    void pushMatrix() override { modelViewStack.push_back(modelView); }
+    void popMatrix() override {
+        if (modelViewStack.empty()) return;
+        modelView = modelViewStack.back();
+        modelViewStack.pop_back();
+    }
+    void translate(float x, float y) override { modelView = glm::translate(modelView, glm::vec3(x, y, 0.0f)); }
+    void rotate(float degrees) override { modelView = glm::rotate(modelView, glm::radians(degrees), glm::vec3(0.0f, 0.0f, 1.0f)); }
+    void scale(float x, float y) override { modelView = glm::scale(modelView, glm::vec3(x, y, 1.0f)); }
+
+    void begin(GLenum mode) override {
+        immediateMode = mode;
+        immediatePositions.clear();
+        immediateColors.clear();
+        immediateNormals.clear();
+    }
+    void end() override {
+        VertexArrays arrays;
+        arrays.positions = immediatePositions.data();
+        arrays.colors = immediateColors.data();
+        arrays.normals = lighting ? immediateNormals.data() : nullptr;
+        drawArrays(immediateMode, (int)immediatePositions.size() / 2, arrays);
+    }
+    void vertex2f(float x, float y) override {
+        immediatePositions.insert(immediatePositions.end(), { x, y });
+        immediateColors.insert(immediateColors.end(), { color.r, color.g, color.b, color.a });
+        immediateNormals.insert(immediateNormals.end(), { normal.x, normal.y, normal.z });
+    }
+    void color4f(float r, float g, float b, float a) override { color = glm::vec4(r, g, b, a); }
+    void normal3f(float x, float y, float z) override { normal = glm::vec3(x, y, z); }
+
+    void drawArrays(GLenum mode, int count, const VertexArrays& arrays) override {
+        if (count <= 0) return;
+        const Program& program = texture ? textured : (lighting ? lit : flat);
+        glExt.useProgram(program.id);
+        glm::mat4 mvp = projection * modelView;
+        glExt.uniformMatrix4fv(program.mvp, 1, GL_FALSE, glm::value_ptr(mvp));
+
+        if (!streamAttribute(ATTRIB_POSITION, arrays.positionSize, GL_FLOAT, arrays.positions, count * arrays.positionSize * sizeof(float))) return;
+        if (&program == &textured) {
+            glExt.uniform1f(program.alphaRef, alphaTest ? alphaRef : -1.0f);
+            if (!streamAttribute(ATTRIB_TEXCOORD, 2, GL_FLOAT, arrays.texCoords, count * 2 * sizeof(float))) return;
+        }
+        else {
+            size_t colorBytes = count * arrays.colorSize * (arrays.colorType == GL_UNSIGNED_BYTE ? 1 : sizeof(float));
+            if (!streamAttribute(ATTRIB_COLOR, arrays.colorSize, arrays.colorType, arrays.colors, colorBytes)) return;
+        }
+        if (&program == &lit) {
+            glm::mat3 linear(modelView);
+            glm::mat3 normalMatrix = glm::determinant(linear) != 0.0f ? glm::transpose(glm::inverse(linear)) : linear;
+            glExt.uniformMatrix4fv(program.modelView, 1, GL_FALSE, glm::value_ptr(modelView));
+            glExt.uniformMatrix3fv(program.normalMatrix, 1, GL_FALSE, glm::value_ptr(normalMatrix));
+            glExt.uniform4fv(program.lightPosition, 1, glm::value_ptr(lightPosition));
+            glExt.uniform4fv(program.lightDiffuse, 1, glm::value_ptr(lightDiffuse));
+            glExt.uniform4fv(program.ambient, 1, glm::value_ptr(globalAmbient));
+            if (!streamAttribute(ATTRIB_NORMAL, 3, GL_FLOAT, arrays.normals, count * 3 * sizeof(float))) return;
+        }
+
+        if (mode == GL_QUADS) {
+            int quadCount = count / 4;
+            ensureQuadIndices(quadCount);
+            glDrawElements(GL_TRIANGLES, quadCount * 6, GL_UNSIGNED_INT, nullptr);
+        }
+        else glDrawArrays(mode == GL_POLYGON ? GL_TRIANGLE_FAN : mode, 0, count);
+    }
+
+    void drawSprites(GLuint tex, const SpriteInstance* sprites, int count) override {
+        if (count <= 0) return;
+        size_t offset = 0;
+        if (!streamUpload(sprites, count * sizeof(SpriteInstance), offset)) return;
+        glExt.useProgram(sprite.id);
+        glm::mat4 mvp = projection * modelView;
+        glExt.uniformMatrix4fv(sprite.mvp, 1, GL_FALSE, glm::value_ptr(mvp));
+        glBindTexture(GL_TEXTURE_2D, tex);
+        const GLuint spriteAttribs[] = { ATTRIB_SPRITE_RECT, ATTRIB_SPRITE_TEXRECT, ATTRIB_SPRITE_TINT };
+        for (int k = 0; k < 3; ++k) {
+            glExt.enableVertexAttribArray(spriteAttribs[k]);
+            glExt.vertexAttribPointer(spriteAttribs[k], 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance),
+                (const void*)(offset + k * 4 * sizeof(float)));
+            glExt.vertexAttribDivisor(spriteAttribs[k], 1);
+        }
+        glExt.drawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
+        for (GLuint index : spriteAttribs) {
+            glExt.vertexAttribDivisor(index, 0);
+            glExt.disableVertexAttribArray(index);
+        }
+        glBindTexture(GL_TEXTURE_2D, texture);
+    }
+
+    void setLight(const float position[4], const float diffuse[4]) override {
+        // Like glLightfv, the position is taken into eye space now
+        lightPosition = modelView * glm::vec4(position[0], position[1], position[2], position[3]);
+        lightDiffuse = glm::vec4(diffuse[0], diffuse[1], diffuse[2], diffuse[3]);
+    }
+    void enableColorMaterial() override {}
+    // GLUT bitmap fonts need the raster position, which core profiles
+    // removed; drawText uses the embedded font's atlas instead
+    void drawBitmapText(float, float, void*, const std::string&) override {}
+
+protected:
+    void applyLighting(bool on) override { lighting = on; }
+    void applyTexture(GLuint tex) override {
+        texture = tex;
+        glBindTexture(GL_TEXTURE_2D, tex);
+    }
+    void applyAlphaTest(bool on, float ref) override {
+        alphaTest = on;
+        alphaRef = ref;
+    }
+
+private:
+    enum {
+        ATTRIB_POSITION = 0, ATTRIB_COLOR = 1, ATTRIB_NORMAL = 2, ATTRIB_TEXCOORD = 3,
+        ATTRIB_SPRITE_RECT = 4, ATTRIB_SPRITE_TEXRECT = 5, ATTRIB_SPRITE_TINT = 6
+    };
+    static const size_t STREAM_SEGMENT_BYTES = 4 << 20;
+    static const int STREAM_SEGMENTS = 3;
+
+    struct Program {
+        GLuint id = 0;
+        GLint mvp = -1;
+        GLint modelView = -1;
+        GLint normalMatrix = -1;
+        GLint lightPosition = -1;
+        GLint lightDiffuse = -1;
+        GLint ambient = -1;
+        GLint texture = -1;
+        GLint alphaRef = -1;
+    };
+
+    GLuint compileShader(GLenum type, const char* source) {
+        GLuint shader = glExt.createShader(type);
+        glExt.shaderSource(shader, 1, &source, nullptr);
+        glExt.compileShader(shader);
+        GLint ok = 0;
+        glExt.getShaderiv(shader, GL_COMPILE_STATUS, &ok);
+        if (!ok) {
+            char log[1024] = "";
+            glExt.getShaderInfoLog(shader, sizeof(log), nullptr, log);
+            std::cerr << "Core renderer: shader compile failed\n" << log << std::endl;
+            glExt.deleteShader(shader);
+            return 0;
+        }
+        return shader;
+    }
+
+    bool buildProgram(Program& program, const char* vertexSource, const char* fragmentSource) {
+        GLuint vs = compileShader(GL_VERTEX_SHADER, vertexSource);
+        GLuint fs = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+        if (!vs || !fs) return false;
+        program.id = glExt.createProgram();
+        glExt.attachShader(program.id, vs);
+        glExt.attachShader(program.id, fs);
+        glExt.linkProgram(program.id);
+        glExt.deleteShader(vs);
+        glExt.deleteShader(fs);
+        GLint ok = 0;
+        glExt.getProgramiv(program.id, GL_LINK_STATUS, &ok);
+        if (!ok) {
+            char log[1024] = "";
+            glExt.getProgramInfoLog(program.id, sizeof(log), nullptr, log);
+            std::cerr << "Core renderer: program link failed\n" << log << std::endl;
+            return false;
+        }
+        program.mvp = glExt.getUniformLocation(program.id, "uMvp");
+        program.modelView = glExt.getUniformLocation(program.id, "uModelView");
+        program.normalMatrix = glExt.getUniformLocation(program.id, "uNormalMatrix");
+        program.lightPosition = glExt.getUniformLocation(program.id, "uLightPosition");
+        program.lightDiffuse = glExt.getUniformLocation(program.id, "uLightDiffuse");
+        program.ambient = glExt.getUniformLocation(program.id, "uAmbient");
+        program.texture = glExt.getUniformLocation(program.id, "uTexture");
+        program.alphaRef = glExt.getUniformLocation(program.id, "uAlphaRef");
+        return true;
+    }
+
+    // Appends data to this frame's part of the stream buffer, returns its offset
+    bool streamUpload(const void* data, size_t bytes, size_t& offset) {
+        size_t aligned = (bytes + 15) & ~(size_t)15;
+        if (aligned > STREAM_SEGMENT_BYTES) {
+            std::cerr << "Core renderer: draw of " << bytes << " bytes exceeds the stream buffer" << std::endl;
+            return false;
+        }
+        if (streamHead + aligned > STREAM_SEGMENT_BYTES) {
+            // Out of room mid-frame: let the GPU drain what it has already read
+            if (streamMapped) glFinish();
+            else glExt.bufferData(GL_ARRAY_BUFFER, STREAM_SEGMENT_BYTES, nullptr, GL_STREAM_DRAW);
+            streamHead = 0;
+        }
+        offset = streamHead;
+        if (streamMapped) {
+            offset += streamSegment * STREAM_SEGMENT_BYTES;
+            memcpy(streamMapped + offset, data, bytes);
+        }
+        else glExt.bufferSubData(GL_ARRAY_BUFFER, offset, bytes, data);
+        streamHead += aligned;
+        return true;
+    }
+
+    // Missing colour and normal streams become constant attributes
+    bool streamAttribute(GLuint index, int size, GLenum type, const void* data, size_t bytes) {
+        if (!data) {
+            glExt.disableVertexAttribArray(index);
+            if (index == ATTRIB_COLOR) glExt.vertexAttrib4f(index, color.r, color.g, color.b, color.a);
+            else if (index == ATTRIB_NORMAL) glExt.vertexAttrib4f(index, normal.x, normal.y, normal.z, 1.0f);
+            return index != ATTRIB_POSITION && index != ATTRIB_TEXCOORD;
+        }
+        size_t offset = 0;
+        if (!streamUpload(data, bytes, offset)) return false;
+        glExt.enableVertexAttribArray(index);
+        glExt.vertexAttribPointer(index, size, type, type == GL_UNSIGNED_BYTE ? GL_TRUE : GL_FALSE, 0, (const void*)offset);
+        return true;
+    }
+
+    // Quads are drawn as two triangles each from a shared index buffer
+    void ensureQuadIndices(int quadCount) {
+        if (quadCount <= quadIndexCapacity) return;
+        int capacity = std::max(quadIndexCapacity * 2, std::max(quadCount, 1024));
+        std::vector<GLuint> indices;
+        indices.reserve(capacity * 6);
+        for (GLuint q = 0; q < (GLuint)capacity; ++q) {
+            GLuint v = q * 4;
+            indices.insert(indices.end(), { v, v + 1, v + 2, v, v + 2, v + 3 });
+        }
+        glExt.bufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+        quadIndexCapacity = capacity;
+    }
+
+    Program flat, lit, textured, sprite;
+    GLuint vao = 0;
+    GLuint quadIndexBuffer = 0;
+    int quadIndexCapacity = 0;
+
+    GLuint streamBuffer = 0;
+    unsigned char* streamMapped = nullptr;
+    int streamSegment = 0;
+    size_t streamHead = 0;
+    void* streamFences[STREAM_SEGMENTS] = {};
+
+    glm::mat4 projection = glm::mat4(1.0f);
+    glm::mat4 modelView = glm::mat4(1.0f);
+    std::vector<glm::mat4> projectionStack;
+    std::vector<glm::mat4> modelViewStack;
+
+    GLenum immediateMode = GL_POINTS;
+    std::vector<float> immediatePositions;
+    std::vector<float> immediateColors;
+    std::vector<float> immediateNormals;
+    glm::vec3 normal = glm::vec3(0.0f, 0.0f, 1.0f);
+
+    bool lighting = false;
+    glm::vec4 lightPosition = glm::vec4(0.0f, 0.0f, 1.0f, 0.0f);
+    glm::vec4 lightDiffuse = glm::vec4(1.0f);
+    glm::vec4 globalAmbient = glm::vec4(0.2f, 0.2f, 0.2f, 1.0f);
+    GLuint texture = 0;
+    bool alphaTest = false;
+    float alphaRef = 0.0f;
+};
+
+static LegacyRenderer legacyRenderer;
+static CoreRenderer coreRenderer;
+static Renderer* gfx = &legacyRenderer;
+
+// Finish the frame: swap in a window, wait for the GPU when headless
+void presentFrame() {
+    gfx->endFrame();
+    if (isHeadless) glFinish();
+    else glutSwapBuffers();
+}
+
 // ----------------- Initialization -----------------
+void initFrondMesh(FrondMesh& mesh, float topX, float topY, float leafLength, float swayAmplitude) {
+    mesh.restVertices.clear();
+    mesh.swayDirs.clear();
+    mesh.swayAmplitude = swayAmplitude;
+    mesh.lastT = -1.0f;
+
+    int leafSegments = 18;
+    int leaflets = 6;
+    for (int f = 0; f < FROND_COUNT; ++f) {
+        float angle = 2.0f * PI / FROND_COUNT * f;
+        float ca = cosf(angle), sa = sinf(angle);
+        for (int s = 0; s < leafSegments; ++s) {
+            float u = (float)s / (leafSegments - 1);
+            float stemX = leafLength * u;
+            float stemY = sinf(u * PI) * 10.0f;
+            for (int l = 0; l < leaflets; ++l) {
+                float leafletY = (l - leaflets / 2) * 6.0f * (1.0f - u);
+                float leafletLength = 24.0f * (1.0f - u) + 10.0f;
+                float leafletHeight = 8.0f;
+                float corners[4][2] = {
+                    { stemX, stemY + leafletY },
+                    { stemX + leafletLength, stemY + leafletY },
+                    { stemX + leafletLength, stemY + leafletY + leafletHeight },
+                    { stemX, stemY + leafletY + leafletHeight } };
+                for (auto& c : corners) {
+                    mesh.restVertices.insert(mesh.restVertices.end(), { topX + ca * c[0] - sa * c[1], topY + sa * c[0] + ca * c[1] });
+                    mesh.swayDirs.insert(mesh.swayDirs.end(), { -sa * u, ca * u });
+                }
+            }
+        }
+    }
+    mesh.vertsPerFrond = (int)(mesh.restVertices.size() / 2 / FROND_COUNT);
+    mesh.vertices = mesh.restVertices;
+    // Sway directions are at most unit length
+    Bounds& b = mesh.bounds;
+    b = pointBounds(mesh.restVertices.data(), mesh.restVertices.size() / 2);
+    float sway = fabsf(swayAmplitude);
+    b = { b.minX - sway, b.minY - sway, b.maxX + sway, b.maxY + sway };
+}
+
+void updateFrondMesh(FrondMesh& mesh, float t) {
+    if (t == mesh.lastT) return;
+    mesh.lastT = t;
+    int floatsPerFrond = mesh.vertsPerFrond * 2;
+    for (int f = 0; f < FROND_COUNT; ++f) {
+        float sway = sinf(t * 1.8f + f) * mesh.swayAmplitude;
+        const float* rest = mesh.restVertices.data() + f * floatsPerFrond;
+        const float* dir = mesh.swayDirs.data() + f * floatsPerFrond;
+        float* out = mesh.vertices.data() + f * floatsPerFrond;
+        for (int k = 0; k < floatsPerFrond; ++k) out[k] = rest[k] + dir[k] * sway;
+    }
+}
+
 void initPalmTreeGeometry() {
+    treeTrunkVertices.clear();
+    treeTrunkColors.clear();
+    treeTrunkNormals.clear();
+    smallTreeTrunkVertices.clear();
+
     float trunkW = 60.0f;
     float trunkH = 250.0f;
 
@@ -72,56 +1361,488 @@ void initPalmTreeGeometry() {
         for (int k = 0; k < 3; k++) treeTrunkColors.insert(treeTrunkColors.end(), { r, g, b });
         for (int k = 0; k < 3; k++) treeTrunkNormals.insert(treeTrunkNormals.end(), { 0, 0, 1 });
     }
+
+    float smallTrunkW = 40.0f;
+    float smallTrunkH = 180.0f;
+    for (int i = 0; i < 10; ++i) {
+        float y0 = smallTrunkH * i / 10.0f;
+        float y1 = smallTrunkH * (i + 1) / 10.0f;
+        float w0 = smallTrunkW * (1.0f - i * 0.05f);
+        float w1 = smallTrunkW * (1.0f - (i + 1) * 0.05f);
+        float offsetX0 = powf((float)i / 10.0f, 2.0f) * 18.0f;
+        float offsetX1 = powf((float)(i + 1) / 10.0f, 2.0f) * 18.0f;
+        smallTreeTrunkVertices.insert(smallTreeTrunkVertices.end(), {
+            -w0 * 0.5f + offsetX0, y0,
+            w0 * 0.5f + offsetX0, y0,
+            w1 * 0.5f + offsetX1, y1,
+            -w1 * 0.5f + offsetX1, y1 });
+    }
+    treeTrunkBounds = pointBounds(treeTrunkVertices.data(), treeTrunkVertices.size() / 3, 3);
+    smallTreeTrunkBounds = pointBounds(smallTreeTrunkVertices.data(), smallTreeTrunkVertices.size() / 2);
+
+    float topOffsetX = powf(1.0f, 2.0f) * 18.0f;
+    initFrondMesh(largeFrondMesh, topOffsetX, trunkH, 150.0f, 6.0f);
+    initFrondMesh(smallFrondMesh, topOffsetX, smallTrunkH, 100.0f, 5.0f);
+}
+
+void initSandGrains(float topY) {
+    sandGrainVertices.clear();
+    sandGrainColorsDay.clear();
+    sandGrainColorsNight.clear();
+    sandGrainTopY = topY;
+
+    int grainH = (int)(topY - 10);
+    if (grainH < 1) return;
+
+    // x, y and shade of each grain
+    std::vector<float> u(SAND_GRAIN_COUNT * 3);
+    glm::linearRand(0.0f, 1.0f, SAND_SEED, 0, u.data(), u.size());
+    for (int i = 0; i < SAND_GRAIN_COUNT; ++i) {
+        float rx = floorf(u[i * 3 + 0] * WIN_W);
+        float ry = floorf(u[i * 3 + 1] * grainH);
+        float shade = 0.9f + 0.2f * u[i * 3 + 2];
+        sandGrainVertices.insert(sandGrainVertices.end(), { rx, ry });
+        sandGrainColorsDay.insert(sandGrainColorsDay.end(), { 0.75f * shade, 0.64f * shade, 0.42f * shade, 0.3f });
+        sandGrainColorsNight.insert(sandGrainColorsNight.end(), { 0.42f * shade, 0.38f * shade, 0.28f * shade, 0.3f });
+    }
 }
 
-void initStars() {
-    srand(time(NULL));
-    for (int i = 0; i < 200; ++i) {
-        stars.push_back({ (float)(rand() % WIN_W), (float)(rand() % (int)(WIN_H * 0.6f)) + WIN_H * 0.4f });
+void initStars(int count = 200) {
+    // Deterministic clocks also get a deterministic sky. Stars use the even
+    // seed of the pair and shooting stars the odd one.
+    skySeed = sceneClock.mode == ClockMode::RealTime ? (glm::uint64)time(NULL) : 1u;
+    sStarSpawnCount = 0;
+    std::vector<float> u(count * 2);
+    glm::linearRand(0.0f, 1.0f, skySeed * 2, 0, u.data(), u.size());
+
+    stars = StarField();
+    stars.positions.reserve(count * 2);
+    stars.phaseSin.reserve(count);
+    stars.phaseCos.reserve(count);
+    stars.colors.reserve(count * 4);
+    for (int i = 0; i < count; ++i) {
+        float x = floorf(u[i * 2 + 0] * WIN_W);
+        float y = floorf(u[i * 2 + 1] * (int)(WIN_H * 0.6f)) + WIN_H * 0.4f;
+        stars.positions.insert(stars.positions.end(), { x, y });
+        stars.phaseSin.push_back(sinf(x * 0.1f));
+        stars.phaseCos.push_back(cosf(x * 0.1f));
+        stars.colors.insert(stars.colors.end(), { 255, 255, 255, 255 });
     }
+    stars.bounds = pointBounds(stars.positions.data(), count);
 }
 
 // ----------------- Text Helpers -----------------
+// Printable ASCII of each GLUT bitmap font is rasterized once into a glyph
+// atlas, and each string keeps its laid-out quads, so a string costs one
+// sprite batch instead of a glBitmap per character. Rasterizing needs
+// glBitmap and a GLUT window, so legacy headless runs keep the old path.
+// Core profiles have no glBitmap at all; their atlas is baked from the
+// embedded font below instead, and all of their text goes through it.
+const int GLYPH_FIRST = 32;
+const int GLYPH_COUNT = 95;
+const int GLYPH_COLUMNS = 16;
+const int GLYPH_PAD = 2;
+const size_t TEXT_LAYOUT_LIMIT = 256;
+
+// X11 misc-fixed 8x13 (public domain, the font behind GLUT_BITMAP_8_BY_13)
+// for printable ASCII: one byte per row from the bottom up, leftmost pixel
+// in the top bit, baseline above the third row
+const int FIXED_FONT_W = 8;
+const int FIXED_FONT_ROWS = 13;
+const int FIXED_FONT_DESCENT = 3;
+const unsigned char FIXED_FONT[GLYPH_COUNT][FIXED_FONT_ROWS] = {
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},  // space
+    {0x00,0x00,0x00,0x10,0x00,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x00},  // !
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x24,0x24,0x24,0x00},  // "
+    {0x00,0x00,0x00,0x00,0x24,0x24,0x7e,0x24,0x7e,0x24,0x24,0x00,0x00},  // #
+    {0x00,0x00,0x00,0x10,0x78,0x14,0x14,0x38,0x50,0x50,0x3c,0x10,0x00},  // $
+    {0x00,0x00,0x00,0x44,0x2a,0x24,0x10,0x08,0x08,0x24,0x52,0x22,0x00},  // %
+    {0x00,0x00,0x00,0x3a,0x44,0x4a,0x30,0x48,0x48,0x30,0x00,0x00,0x00},  // &
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x40,0x30,0x38,0x00},  // '
+    {0x00,0x00,0x00,0x04,0x08,0x08,0x10,0x10,0x10,0x08,0x08,0x04,0x00},  // (
+    {0x00,0x00,0x00,0x20,0x10,0x10,0x08,0x08,0x08,0x10,0x10,0x20,0x00},  // )
+    {0x00,0x00,0x00,0x00,0x00,0x24,0x18,0x7e,0x18,0x24,0x00,0x00,0x00},  // *
+    {0x00,0x00,0x00,0x00,0x00,0x10,0x10,0x7c,0x10,0x10,0x00,0x00,0x00},  // +
+    {0x00,0x00,0x40,0x30,0x38,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},  // ,
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7e,0x00,0x00,0x00,0x00,0x00},  // -
+    {0x00,0x00,0x10,0x38,0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},  // .
+    {0x00,0x00,0x00,0x80,0x80,0x40,0x20,0x10,0x08,0x04,0x02,0x02,0x00},  // /
+    {0x00,0x00,0x00,0x18,0x24,0x42,0x42,0x42,0x42,0x42,0x24,0x18,0x00},  // 0
+    {0x00,0x00,0x00,0x7c,0x10,0x10,0x10,0x10,0x10,0x50,0x30,0x10,0x00},  // 1
+    {0x00,0x00,0x00,0x7e,0x40,0x20,0x18,0x04,0x02,0x42,0x42,0x3c,0x00},  // 2
+    {0x00,0x00,0x00,0x3c,0x42,0x02,0x02,0x1c,0x08,0x04,0x02,0x7e,0x00},  // 3
+    {0x00,0x00,0x00,0x04,0x04,0x7e,0x44,0x44,0x24,0x14,0x0c,0x04,0x00},  // 4
+    {0x00,0x00,0x00,0x3c,0x42,0x02,0x02,0x62,0x5c,0x40,0x40,0x7e,0x00},  // 5
+    {0x00,0x00,0x00,0x3c,0x42,0x42,0x62,0x5c,0x40,0x40,0x20,0x1c,0x00},  // 6
+    {0x00,0x00,0x00,0x20,0x20,0x10,0x10,0x08,0x08,0x04,0x02,0x7e,0x00},  // 7
+    {0x00,0x00,0x00,0x3c,0x42,0x42,0x42,0x3c,0x42,0x42,0x42,0x3c,0x00},  // 8
+    {0x00,0x00,0x00,0x38,0x04,0x02,0x02,0x3a,0x46,0x42,0x42,0x3c,0x00},  // 9
+    {0x00,0x00,0x10,0x38,0x10,0x00,0x00,0x10,0x38,0x10,0x00,0x00,0x00},  // :
+    {0x00,0x00,0x40,0x30,0x38,0x00,0x00,0x10,0x38,0x10,0x00,0x00,0x00},  // ;
+    {0x00,0x00,0x00,0x02,0x04,0x08,0x10,0x20,0x10,0x08,0x04,0x02,0x00},  // <
+    {0x00,0x00,0x00,0x00,0x00,0x7e,0x00,0x00,0x7e,0x00,0x00,0x00,0x00},  // =
+    {0x00,0x00,0x00,0x40,0x20,0x10,0x08,0x04,0x08,0x10,0x20,0x40,0x00},  // >
+    {0x00,0x00,0x00,0x08,0x00,0x08,0x08,0x04,0x02,0x42,0x42,0x3c,0x00},  // ?
+    {0x00,0x00,0x00,0x3c,0x40,0x4a,0x56,0x52,0x4e,0x42,0x42,0x3c,0x00},  // @
+    {0x00,0x00,0x00,0x42,0x42,0x42,0x7e,0x42,0x42,0x42,0x24,0x18,0x00},  // A
+    {0x00,0x00,0x00,0xfc,0x42,0x42,0x42,0x7c,0x42,0x42,0x42,0xfc,0x00},  // B
+    {0x00,0x00,0x00,0x3c,0x42,0x40,0x40,0x40,0x40,0x40,0x42,0x3c,0x00},  // C
+    {0x00,0x00,0x00,0xfc,0x42,0x42,0x42,0x42,0x42,0x42,0x42,0xfc,0x00},  // D
+    {0x00,0x00,0x00,0x7e,0x40,0x40,0x40,0x78,0x40,0x40,0x40,0x7e,0x00},  // E
+    {0x00,0x00,0x00,0x40,0x40,0x40,0x40,0x78,0x40,0x40,0x40,0x7e,0x00},  // F
+    {0x00,0x00,0x00,0x3a,0x46,0x42,0x4e,0x40,0x40,0x40,0x42,0x3c,0x00},  // G
+    {0x00,0x00,0x00,0x42,0x42,0x42,0x42,0x7e,0x42,0x42,0x42,0x42,0x00},  // H
+    {0x00,0x00,0x00,0x7c,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x7c,0x00},  // I
+    {0x00,0x00,0x00,0x38,0x44,0x04,0x04,0x04,0x04,0x04,0x04,0x1f,0x00},  // J
+    {0x00,0x00,0x00,0x42,0x44,0x48,0x50,0x60,0x50,0x48,0x44,0x42,0x00},  // K
+    {0x00,0x00,0x00,0x7e,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x00},  // L
+    {0x00,0x00,0x00,0x82,0x82,0x82,0x92,0x92,0xaa,0xc6,0x82,0x82,0x00},  // M
+    {0x00,0x00,0x00,0x42,0x42,0x42,0x46,0x4a,0x52,0x62,0x42,0x42,0x00},  // N
+    {0x00,0x00,0x00,0x3c,0x42,0x42,0x42,0x42,0x42,0x42,0x42,0x3c,0x00},  // O
+    {0x00,0x00,0x00,0x40,0x40,0x40,0x40,0x7c,0x42,0x42,0x42,0x7c,0x00},  // P
+    {0x00,0x00,0x02,0x3c,0x4a,0x52,0x42,0x42,0x42,0x42,0x42,0x3c,0x00},  // Q
+    {0x00,0x00,0x00,0x42,0x44,0x48,0x50,0x7c,0x42,0x42,0x42,0x7c,0x00},  // R
+    {0x00,0x00,0x00,0x3c,0x42,0x02,0x02,0x3c,0x40,0x40,0x42,0x3c,0x00},  // S
+    {0x00,0x00,0x00,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0xfe,0x00},  // T
+    {0x00,0x00,0x00,0x3c,0x42,0x42,0x42,0x42,0x42,0x42,0x42,0x42,0x00},  // U
+    {0x00,0x00,0x00,0x10,0x28,0x28,0x28,0x44,0x44,0x44,0x82,0x82,0x00},  // V
+    {0x00,0x00,0x00,0x44,0xaa,0x92,0x92,0x92,0x82,0x82,0x82,0x82,0x00},  // W
+    {0x00,0x00,0x00,0x82,0x82,0x44,0x28,0x10,0x28,0x44,0x82,0x82,0x00},  // X
+    {0x00,0x00,0x00,0x10,0x10,0x10,0x10,0x10,0x28,0x44,0x82,0x82,0x00},  // Y
+    {0x00,0x00,0x00,0x7e,0x40,0x40,0x20,0x10,0x08,0x04,0x02,0x7e,0x00},  // Z
+    {0x00,0x00,0x00,0x3c,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x00},  // [
+    {0x00,0x00,0x00,0x02,0x02,0x04,0x08,0x10,0x20,0x40,0x80,0x80,0x00},  // backslash
+    {0x00,0x00,0x00,0x78,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x78,0x00},  // ]
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x44,0x28,0x10,0x00},  // ^
+    {0x00,0x00,0xfe,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},  // _
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x04,0x18,0x38,0x00},  // `
+    {0x00,0x00,0x00,0x3a,0x46,0x42,0x3e,0x02,0x3c,0x00,0x00,0x00,0x00},  // a
+    {0x00,0x00,0x00,0x5c,0x62,0x42,0x42,0x62,0x5c,0x40,0x40,0x40,0x00},  // b
+    {0x00,0x00,0x00,0x3c,0x42,0x40,0x40,0x42,0x3c,0x00,0x00,0x00,0x00},  // c
+    {0x00,0x00,0x00,0x3a,0x46,0x42,0x42,0x46,0x3a,0x02,0x02,0x02,0x00},  // d
+    {0x00,0x00,0x00,0x3c,0x42,0x40,0x7e,0x42,0x3c,0x00,0x00,0x00,0x00},  // e
+    {0x00,0x00,0x00,0x20,0x20,0x20,0x20,0x7c,0x20,0x20,0x22,0x1c,0x00},  // f
+    {0x00,0x3c,0x42,0x3c,0x40,0x38,0x44,0x44,0x3a,0x00,0x00,0x00,0x00},  // g
+    {0x00,0x00,0x00,0x42,0x42,0x42,0x42,0x62,0x5c,0x40,0x40,0x40,0x00},  // h
+    {0x00,0x00,0x00,0x7c,0x10,0x10,0x10,0x10,0x30,0x00,0x10,0x00,0x00},  // i
+    {0x00,0x38,0x44,0x44,0x04,0x04,0x04,0x04,0x0c,0x00,0x04,0x00,0x00},  // j
+    {0x00,0x00,0x00,0x42,0x44,0x48,0x70,0x48,0x44,0x40,0x40,0x40,0x00},  // k
+    {0x00,0x00,0x00,0x7c,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x30,0x00},  // l
+    {0x00,0x00,0x00,0x82,0x92,0x92,0x92,0x92,0xec,0x00,0x00,0x00,0x00},  // m
+    {0x00,0x00,0x00,0x42,0x42,0x42,0x42,0x62,0x5c,0x00,0x00,0x00,0x00},  // n
+    {0x00,0x00,0x00,0x3c,0x42,0x42,0x42,0x42,0x3c,0x00,0x00,0x00,0x00},  // o
+    {0x00,0x40,0x40,0x40,0x5c,0x62,0x42,0x62,0x5c,0x00,0x00,0x00,0x00},  // p
+    {0x00,0x02,0x02,0x02,0x3a,0x46,0x42,0x46,0x3a,0x00,0x00,0x00,0x00},  // q
+    {0x00,0x00,0x00,0x20,0x20,0x20,0x20,0x22,0x5c,0x00,0x00,0x00,0x00},  // r
+    {0x00,0x00,0x00,0x3c,0x42,0x0c,0x30,0x42,0x3c,0x00,0x00,0x00,0x00},  // s
+    {0x00,0x00,0x00,0x1c,0x22,0x20,0x20,0x20,0x7c,0x20,0x20,0x00,0x00},  // t
+    {0x00,0x00,0x00,0x3a,0x44,0x44,0x44,0x44,0x44,0x00,0x00,0x00,0x00},  // u
+    {0x00,0x00,0x00,0x10,0x28,0x28,0x44,0x44,0x44,0x00,0x00,0x00,0x00},  // v
+    {0x00,0x00,0x00,0x44,0xaa,0x92,0x92,0x82,0x82,0x00,0x00,0x00,0x00},  // w
+    {0x00,0x00,0x00,0x42,0x24,0x18,0x18,0x24,0x42,0x00,0x00,0x00,0x00},  // x
+    {0x00,0x3c,0x42,0x02,0x3a,0x46,0x42,0x42,0x42,0x00,0x00,0x00,0x00},  // y
+    {0x00,0x00,0x00,0x7e,0x20,0x10,0x08,0x04,0x7e,0x00,0x00,0x00,0x00},  // z
+    {0x00,0x00,0x00,0x0e,0x10,0x10,0x08,0x30,0x08,0x10,0x10,0x0e,0x00},  // {
+    {0x00,0x00,0x00,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x00},  // |
+    {0x00,0x00,0x00,0x70,0x08,0x08,0x10,0x0c,0x10,0x08,0x08,0x70,0x00},  // }
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x48,0x54,0x24,0x00},  // ~
+};
+
+struct FontAtlas {
+    bool valid = false;
+    GLuint texture = 0;
+    int cellW = 0;
+    int cellH = 0;
+    int baseline = 0;   // pen position above the cell bottom
+    int texW = 0;
+    int texH = 0;
+    int advance[GLYPH_COUNT];
+};
+
+struct TextLayout {
+    std::vector<SpriteInstance> quads;   // relative to the pen start
+    GLuint texture = 0;
+    int width = 0;
+};
+
+struct TextCache {
+    bool enabled = true;
+    GLuint fbo = 0;
+    std::map<void*, FontAtlas> fonts;
+    std::map<std::pair<void*, std::string>, TextLayout> layouts;
+};
+static TextCache textCache;
+
+bool textAtlasUsable() {
+    if (rendererBackend == RendererBackend::Core) return true;
+    return textCache.enabled && !isHeadless && glExt.framebufferObject;
+}
+
+void createAtlasTexture(FontAtlas& atlas, const void* pixels) {
+    if (!atlas.texture) glGenTextures(1, &atlas.texture);
+    glBindTexture(GL_TEXTURE_2D, atlas.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, atlas.texW, atlas.texH, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// Pixel size of a GLUT font, which the embedded font is scaled to
+int glutFontPixels(void* font) {
+    if (font == GLUT_BITMAP_HELVETICA_10 || font == GLUT_BITMAP_TIMES_ROMAN_10) return 10;
+    if (font == GLUT_BITMAP_HELVETICA_12) return 12;
+    if (font == GLUT_BITMAP_9_BY_15) return 15;
+    if (font == GLUT_BITMAP_HELVETICA_18) return 18;
+    if (font == GLUT_BITMAP_TIMES_ROMAN_24) return 24;
+    return 13;
+}
+
+// The glyphs are scaled to the font's size. Smaller fonts are only
+// narrowed, so that their rows stay one pixel tall and their strings about
+// as wide as the GLUT font's. Each texel's alpha is the coverage of a 4x4
+// grid of samples, which keeps fractional scales even.
+void bakeEmbeddedFont(void* font, FontAtlas& atlas) {
+    const int SAMPLES = 4;
+    float scaleX = glutFontPixels(font) / (float)FIXED_FONT_ROWS;
+    float scaleY = std::max(1.0f, scaleX);
+    int glyphW = (int)lroundf(FIXED_FONT_W * scaleX);
+    int glyphH = (int)lroundf(FIXED_FONT_ROWS * scaleY);
+    for (int i = 0; i < GLYPH_COUNT; ++i) atlas.advance[i] = glyphW;
+    atlas.cellW = glyphW + GLYPH_PAD * 2;
+    atlas.cellH = glyphH + GLYPH_PAD * 2;
+    atlas.baseline = GLYPH_PAD + (int)lroundf(FIXED_FONT_DESCENT * scaleY);
+    atlas.texW = atlas.cellW * GLYPH_COLUMNS;
+    atlas.texH = atlas.cellH * ((GLYPH_COUNT + GLYPH_COLUMNS - 1) / GLYPH_COLUMNS);
+
+    // White with the coverage as alpha, like the rasterized atlas
+    std::vector<unsigned char> pixels((size_t)atlas.texW * atlas.texH * 4, 255);
+    for (size_t i = 3; i < pixels.size(); i += 4) pixels[i] = 0;
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        int cellX = (i % GLYPH_COLUMNS) * atlas.cellW + GLYPH_PAD;
+        int cellY = (i / GLYPH_COLUMNS) * atlas.cellH + GLYPH_PAD;
+        for (int y = 0; y < glyphH; ++y) {
+            for (int x = 0; x < glyphW; ++x) {
+                int covered = 0;
+                for (int sy = 0; sy < SAMPLES; ++sy) {
+                    int row = std::min((int)((y + (sy + 0.5f) / SAMPLES) / scaleY), FIXED_FONT_ROWS - 1);
+                    for (int sx = 0; sx < SAMPLES; ++sx) {
+                        int column = std::min((int)((x + (sx + 0.5f) / SAMPLES) / scaleX), FIXED_FONT_W - 1);
+                        if (FIXED_FONT[i][row] & (0x80 >> column)) ++covered;
+                    }
+                }
+                pixels[((size_t)(cellY + y) * atlas.texW + cellX + x) * 4 + 3] =
+                    (unsigned char)(covered * 255 / (SAMPLES * SAMPLES));
+            }
+        }
+    }
+    createAtlasTexture(atlas, pixels.data());
+}
+
+const FontAtlas* getFontAtlas(void* font) {
+    FontAtlas& atlas = textCache.fonts[font];
+    if (atlas.valid) return &atlas;
+    if (rendererBackend == RendererBackend::Core) {
+        bakeEmbeddedFont(font, atlas);
+        atlas.valid = true;
+        return &atlas;
+    }
+
+    int lineHeight = glutBitmapHeight(font);
+    int maxAdvance = 0;
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        atlas.advance[i] = glutBitmapWidth(font, GLYPH_FIRST + i);
+        maxAdvance = std::max(maxAdvance, atlas.advance[i]);
+    }
+    atlas.cellW = maxAdvance + GLYPH_PAD * 2;
+    atlas.cellH = lineHeight + GLYPH_PAD * 2;
+    atlas.baseline = GLYPH_PAD + lineHeight / 4;
+    atlas.texW = atlas.cellW * GLYPH_COLUMNS;
+    atlas.texH = atlas.cellH * ((GLYPH_COUNT + GLYPH_COLUMNS - 1) / GLYPH_COLUMNS);
+    createAtlasTexture(atlas, NULL);
+
+    // Fonts are baked on first use, which may be inside another offscreen pass
+    GLint previousFbo = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFbo);
+    if (!textCache.fbo) glExt.genFramebuffers(1, &textCache.fbo);
+    glExt.bindFramebuffer(GL_FRAMEBUFFER, textCache.fbo);
+    glExt.framebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, atlas.texture, 0);
+    if (glExt.checkFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        glExt.bindFramebuffer(GL_FRAMEBUFFER, previousFbo);
+        std::cerr << "Text atlas: framebuffer incomplete, drawing bitmap text" << std::endl;
+        textCache.enabled = false;
+        return nullptr;
+    }
+
+    glViewport(0, 0, atlas.texW, atlas.texH);
+    gfx->pushProjection();
+    gfx->setProjection(0, (float)atlas.texW, 0, (float)atlas.texH);
+    gfx->pushMatrix();
+    gfx->loadIdentity();
+    gfx->setLighting(false);
+    bool wasBlending = gfx->blending();
+    gfx->setBlend(false);
+    glm::vec4 savedColor = gfx->currentColor();
+
+    // White glyphs on transparent white: the alpha is the coverage and the
+    // sprite tint supplies the colour. Scissoring keeps overhangs in the cell.
+    glClearColor(1.0f, 1.0f, 1.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    gfx->color4f(1.0f, 1.0f, 1.0f, 1.0f);
+    glEnable(GL_SCISSOR_TEST);
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        int cellX = (i % GLYPH_COLUMNS) * atlas.cellW;
+        int cellY = (i / GLYPH_COLUMNS) * atlas.cellH;
+        glScissor(cellX, cellY, atlas.cellW, atlas.cellH);
+        gfx->drawBitmapText((float)(cellX + GLYPH_PAD), (float)(cellY + atlas.baseline), font,
+            std::string(1, (char)(GLYPH_FIRST + i)));
+    }
+    glDisable(GL_SCISSOR_TEST);
+
+    gfx->color4f(savedColor.r, savedColor.g, savedColor.b, savedColor.a);
+    gfx->setBlend(wasBlending);
+    gfx->popMatrix();
+    gfx->popProjection();
+    glExt.bindFramebuffer(GL_FRAMEBUFFER, previousFbo);
+    glViewport(0, 0, viewportW, viewportH);
+    if (isNightMode) gfx->setLighting(true);
+
+    atlas.valid = true;
+    return &atlas;
+}
+
+// Overlay strings change every frame, so the cache is simply dropped when
+// it grows past the limit; the credits strings are rebuilt on the next frame
+TextLayout* getTextLayout(void* font, const std::string& text) {
+    auto key = std::make_pair(font, text);
+    auto it = textCache.layouts.find(key);
+    if (it != textCache.layouts.end()) return &it->second;
+
+    const FontAtlas* atlas = getFontAtlas(font);
+    if (!atlas) return nullptr;
+    if (textCache.layouts.size() >= TEXT_LAYOUT_LIMIT) textCache.layouts.clear();
+
+    TextLayout& layout = textCache.layouts[key];
+    layout.texture = atlas->texture;
+    layout.quads.reserve(text.size());
+    for (char c : text) {
+        int i = (unsigned char)c - GLYPH_FIRST;
+        if (i < 0 || i >= GLYPH_COUNT) continue;
+        int cellX = (i % GLYPH_COLUMNS) * atlas->cellW;
+        int cellY = (i / GLYPH_COLUMNS) * atlas->cellH;
+        int w = atlas->advance[i] + GLYPH_PAD * 2;
+        if (c != ' ') {
+            SpriteInstance quad;
+            quad.x = (float)(layout.width - GLYPH_PAD);
+            quad.y = (float)-atlas->baseline;
+            quad.w = (float)w;
+            quad.h = (float)atlas->cellH;
+            quad.u0 = (float)cellX / atlas->texW;
+            quad.v0 = (float)cellY / atlas->texH;
+            quad.u1 = (float)(cellX + w) / atlas->texW;
+            quad.v1 = (float)(cellY + atlas->cellH) / atlas->texH;
+            quad.r = quad.g = quad.b = quad.a = 1.0f;
+            layout.quads.push_back(quad);
+        }
+        layout.width += atlas->advance[i];
+    }
+    return &layout;
+}
+
+// Text in the current colour with its baseline at y, starting at x or
+// centred on it. Expects lighting off, like the raster text it replaces.
+void drawText(float x, float y, void* font, const std::string& text, bool centered = false) {
+    TextLayout* layout = textAtlasUsable() ? getTextLayout(font, text) : nullptr;
+    if (!layout) {
+        int textWidth = 0;
+        if (centered) for (char c : text) textWidth += glutBitmapWidth(font, c);
+        gfx->drawBitmapText(x - (textWidth / 2.0f), y, font, text);
+        return;
+    }
+    if (layout->quads.empty()) return;
+
+    const glm::vec4& color = gfx->currentColor();
+    for (SpriteInstance& quad : layout->quads) {
+        quad.r = color.r;
+        quad.g = color.g;
+        quad.b = color.b;
+        quad.a = color.a;
+    }
+    // Snapped like a raster position so glyph texels land on pixels
+    float penX = floorf(centered ? x - layout->width / 2.0f : x);
+    bool wasBlending = gfx->blending();
+    if (!wasBlending) {
+        gfx->setBlend(true);
+        gfx->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    gfx->pushMatrix();
+    gfx->translate(penX, floorf(y));
+    gfx->drawSprites(layout->texture, layout->quads.data(), (int)layout->quads.size());
+    gfx->popMatrix();
+    if (!wasBlending) gfx->setBlend(false);
+}
+
 void drawCenteredText(float x, float y, void* font, const std::string& text) {
-    glDisable(GL_LIGHTING);
-    int textWidth = 0;
-    for (char c : text) textWidth += glutBitmapWidth(font, c);
-    glRasterPos2f(x - (textWidth / 2.0f), y);
-    for (char c : text) glutBitmapCharacter(font, c);
-    if (isNightMode) glEnable(GL_LIGHTING);
+    gfx->setLighting(false);
+    drawText(x, y, font, text, true);
+    if (isNightMode) gfx->setLighting(true);
 }
 
 // ----------------- Basic Shapes -----------------
-void myFilledCircle(float cx, float cy, float r, int n = 48) {
-    glNormal3f(0.0f, 0.0f, 1.0f);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex2f(cx, cy);
+void tessellateUnitCircle(int n, std::vector<float>& verts) {
+    verts.clear();
+    verts.reserve((n + 2) * 2);
+    verts.insert(verts.end(), { 0.0f, 0.0f });
     for (int i = 0; i <= n; ++i) {
         float a = (float)i / n * 2.0f * PI;
-        glVertex2f(cx + cosf(a) * r, cy + sinf(a) * r);
+        verts.insert(verts.end(), { cosf(a), sinf(a) });
     }
-    glEnd();
 }
 
-void myFilledEllipse(float cx, float cy, float rx, float ry, int n = 48) {
-    glNormal3f(0.0f, 0.0f, 1.0f);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex2f(cx, cy);
-    for (int i = 0; i <= n; ++i) {
-        float a = (float)i / n * 2.0f * PI;
-        glVertex2f(cx + cosf(a) * rx, cy + sinf(a) * ry);
+const std::vector<float>& getUnitCircle(int n) {
+    std::vector<float>& verts = unitCircleCache[n];
+    if (verts.empty()) tessellateUnitCircle(n, verts);
+    return verts;
+}
+
+void drawUnitShape(const float* verts, GLenum mode, int count, float x, float y, float sx, float sy) {
+    gfx->pushMatrix();
+    gfx->translate(x, y);
+    gfx->scale(sx, sy);
+    VertexArrays arrays;
+    arrays.positions = verts;
+    gfx->drawArrays(mode, count, arrays);
+    gfx->popMatrix();
+}
+
+// Smallest bucket whose chord sagitta r * (1 - cos(PI / n)) stays under the
+// error bound. Modelview scaling is ignored; the scene only scales by ~5%.
+int circleSegments(float radius, int n) {
+    if (!adaptiveTessellation) return n;
+    const int bucketCount = sizeof(circleLodBuckets) / sizeof(circleLodBuckets[0]);
+    float radiusPx = fabsf(radius) * pixelsPerUnit;
+    if (radiusPx <= maxChordErrorPx * 2.0f) return circleLodBuckets[0];
+    int needed = (int)ceilf(PI / acosf(1.0f - maxChordErrorPx / radiusPx));
+    for (int i = 0; i < bucketCount; ++i) {
+        if (circleLodBuckets[i] >= needed) return circleLodBuckets[i];
     }
-    glEnd();
+    return circleLodBuckets[bucketCount - 1];
+}
+
+void myFilledEllipse(float cx, float cy, float rx, float ry, int n = 48) {
+    const std::vector<float>& verts = getUnitCircle(circleSegments(std::max(fabsf(rx), fabsf(ry)), n));
+    gfx->normal3f(0.0f, 0.0f, 1.0f);
+    drawUnitShape(verts.data(), GL_TRIANGLE_FAN, verts.size() / 2, cx, cy, rx, ry);
+}
+
+void myFilledCircle(float cx, float cy, float r, int n = 48) {
+    myFilledEllipse(cx, cy, r, r, n);
 }
 
 void myFilledRect(float x, float y, float w, float h) {
-    glNormal3f(0.0f, 0.0f, 1.0f);
-    glBegin(GL_QUADS);
-    glVertex2f(x, y);
-    glVertex2f(x + w, y);
-    glVertex2f(x + w, y + h);
-    glVertex2f(x, y + h);
-    glEnd();
+    gfx->normal3f(0.0f, 0.0f, 1.0f);
+    drawUnitShape(unitRectVertices, GL_QUADS, 4, x, y, w, h);
 }
 
 float lerp(float a, float b, float t) {
@@ -129,19 +1850,33 @@ float lerp(float a, float b, float t) {
 }
 
 // ----------------- Credits Screen -----------------
-void drawCredits() {
-    glDisable(GL_LIGHTING);
-
-    glBegin(GL_QUADS);
-    glColor3f(0.2f, 0.1f, 0.4f); glVertex2f(0, WIN_H);
-    glColor3f(0.2f, 0.1f, 0.4f); glVertex2f(WIN_W, WIN_H);
-    glColor3f(0.9f, 0.5f, 0.3f); glVertex2f(WIN_W, 0);
-    glColor3f(0.9f, 0.5f, 0.3f); glVertex2f(0, 0);
-    glEnd();
-
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(1.0f, 1.0f, 1.0f, 0.15f);
+// Only the prompt's alpha changes between frames, so the rest of the screen
+// is rendered once into a window-sized texture; each frame is then a copy of
+// that texture plus the blinking prompt.
+struct CreditsCache {
+    bool enabled = true;
+    GLuint fbo = 0;
+    GLuint texture = 0;
+    int width = 0;
+    int height = 0;
+    bool valid = false;
+};
+static CreditsCache creditsCache;
+
+// Leaves blending on, which the prompt drawn over it relies on
+void drawCreditsPanel() {
+    gfx->setLighting(false);
+
+    gfx->begin(GL_QUADS);
+    gfx->color3f(0.2f, 0.1f, 0.4f); gfx->vertex2f(0, WIN_H);
+    gfx->color3f(0.2f, 0.1f, 0.4f); gfx->vertex2f(WIN_W, WIN_H);
+    gfx->color3f(0.9f, 0.5f, 0.3f); gfx->vertex2f(WIN_W, 0);
+    gfx->color3f(0.9f, 0.5f, 0.3f); gfx->vertex2f(0, 0);
+    gfx->end();
+
+    gfx->setBlend(true);
+    gfx->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    gfx->color4f(1.0f, 1.0f, 1.0f, 0.15f);
 
     float panelW = 600, panelH = 500;
     float panelX = (WIN_W - panelW) / 2;
@@ -149,33 +1884,33 @@ void drawCredits() {
 
     myFilledRect(panelX, panelY, panelW, panelH);
 
-    glColor4f(1.0f, 1.0f, 1.0f, 0.5f);
-    glLineWidth(2.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(panelX, panelY);
-    glVertex2f(panelX + panelW, panelY);
-    glVertex2f(panelX + panelW, panelY + panelH);
-    glVertex2f(panelX, panelY + panelH);
-    glEnd();
+    gfx->color4f(1.0f, 1.0f, 1.0f, 0.5f);
+    gfx->lineWidth(2.0f);
+    gfx->begin(GL_LINE_LOOP);
+    gfx->vertex2f(panelX, panelY);
+    gfx->vertex2f(panelX + panelW, panelY);
+    gfx->vertex2f(panelX + panelW, panelY + panelH);
+    gfx->vertex2f(panelX, panelY + panelH);
+    gfx->end();
 
-    glColor4f(1.0f, 0.9f, 0.4f, 0.9f);
+    gfx->color4f(1.0f, 0.9f, 0.4f, 0.9f);
     myFilledCircle(WIN_W / 2, panelY + panelH - 60, 40);
-    glColor4f(1.0f, 1.0f, 1.0f, 0.2f);
+    gfx->color4f(1.0f, 1.0f, 1.0f, 0.2f);
     myFilledCircle(WIN_W / 2, panelY + panelH - 60, 50);
 
-    glColor3f(1.0f, 1.0f, 1.0f);
+    gfx->color3f(1.0f, 1.0f, 1.0f);
     float startY = panelY + panelH - 140;
 
-    glColor3f(1.0f, 0.95f, 0.8f);
+    gfx->color3f(1.0f, 0.95f, 0.8f);
     drawCenteredText(WIN_W / 2, startY, GLUT_BITMAP_TIMES_ROMAN_24, "SUMMER BEACH PARADISE");
 
-    glColor3f(1.0f, 1.0f, 1.0f);
+    gfx->color3f(1.0f, 1.0f, 1.0f);
     drawCenteredText(WIN_W / 2, startY - 40, GLUT_BITMAP_HELVETICA_18, "Summer Vacation Simulation");
 
-    glBegin(GL_LINES);
-    glVertex2f(WIN_W / 2 - 100, startY - 60);
-    glVertex2f(WIN_W / 2 + 100, startY - 60);
-    glEnd();
+    gfx->begin(GL_LINES);
+    gfx->vertex2f(WIN_W / 2 - 100, startY - 60);
+    gfx->vertex2f(WIN_W / 2 + 100, startY - 60);
+    gfx->end();
 
     drawCenteredText(WIN_W / 2, startY - 100, GLUT_BITMAP_HELVETICA_18, "CREATED BY:");
 
@@ -185,165 +1920,650 @@ void drawCredits() {
     drawCenteredText(WIN_W / 2, namesY - nameSpacing, GLUT_BITMAP_HELVETICA_18, "Josephine J. Santander - 202310348");
     drawCenteredText(WIN_W / 2, namesY - (nameSpacing * 2), GLUT_BITMAP_HELVETICA_18, "Paul Lewis J. Villamil - 202310868");
 
-    glColor3f(0.8f, 1.0f, 0.8f);
+    gfx->color3f(0.8f, 1.0f, 0.8f);
     drawCenteredText(WIN_W / 2, panelY + 70, GLUT_BITMAP_HELVETICA_12, "Mouse Drag: Move Umbrella | 'N': Night Mode | +/-: Zoom");
+}
 
-    float blink = fabs(sin(secs() * 3.0f));
-    glColor4f(1.0f, 1.0f, 1.0f, 0.5f + (blink * 0.5f));
+void drawCreditsPrompt(float t) {
+    float panelY = (WIN_H - 500.0f) / 2;
+    float blink = fabs(sin(t * 3.0f));
+    gfx->color4f(1.0f, 1.0f, 1.0f, 0.5f + (blink * 0.5f));
     drawCenteredText(WIN_W / 2, panelY + 30, GLUT_BITMAP_9_BY_15, "- PRESS ANY KEY TO START -");
+}
+
+bool creditsCacheUsable() {
+    return creditsCache.enabled && glExt.framebufferObject;
+}
+
+// Expects the credits projection (the whole window) to be loaded
+bool updateCreditsCache() {
+    CreditsCache& cc = creditsCache;
+    if (cc.valid && cc.width == viewportW && cc.height == viewportH) return true;
+
+    if (!cc.texture) glGenTextures(1, &cc.texture);
+    glBindTexture(GL_TEXTURE_2D, cc.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, viewportW, viewportH, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if (!cc.fbo) glExt.genFramebuffers(1, &cc.fbo);
+    glExt.bindFramebuffer(GL_FRAMEBUFFER, cc.fbo);
+    glExt.framebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, cc.texture, 0);
+    if (glExt.checkFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        glExt.bindFramebuffer(GL_FRAMEBUFFER, 0);
+        std::cerr << "Credits cache: framebuffer incomplete, drawing credits live" << std::endl;
+        cc.enabled = false;
+        return false;
+    }
+
+    glViewport(0, 0, viewportW, viewportH);
+    drawCreditsPanel();
+    gfx->setBlend(false);
+    glExt.bindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    cc.width = viewportW;
+    cc.height = viewportH;
+    cc.valid = true;
+    return true;
+}
 
-    glDisable(GL_BLEND);
-    glutSwapBuffers();
+void drawCredits() {
+    if (creditsCacheUsable() && updateCreditsCache()) {
+        const float verts[] = { 0, 0, WIN_W, 0, WIN_W, WIN_H, 0, WIN_H };
+        const float texCoords[] = { 0, 0, 1, 0, 1, 1, 0, 1 };
+        gfx->setLighting(false);
+        gfx->setTexture(creditsCache.texture);
+        VertexArrays arrays;
+        arrays.positions = verts;
+        arrays.texCoords = texCoords;
+        gfx->drawArrays(GL_QUADS, 4, arrays);
+        gfx->setTexture(0);
+        gfx->setBlend(true);
+        gfx->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    else drawCreditsPanel();
+
+    drawCreditsPrompt(secs());
+    gfx->setBlend(false);
+    presentFrame();
+}
+
+// ----------------- View Culling -----------------
+// Every scene element has a bounding box in scene units. display() sets the
+// cull window to the frame's gluOrtho2D window, which shrinks as globalZoom
+// goes down, and an element whose box misses it is neither prepared by
+// prepareFrame nor submitted to the draw queue.
+struct ViewCuller {
+    bool enabled = true;
+    Bounds window = { 0.0f, 0.0f, (float)WIN_W, (float)WIN_H };
+};
+static ViewCuller viewCuller;
+
+// Lines and points are widened in pixels, so the window is grown by this
+// much to keep their edges
+const float CULL_PAD_PIXELS = 4.0f;
+
+void setCullWindow(float left, float right, float bottom, float top, float unitsPerPixel) {
+    float pad = CULL_PAD_PIXELS * unitsPerPixel;
+    viewCuller.window = { left - pad, bottom - pad, right + pad, top + pad };
+}
+
+bool isVisible(const Bounds& b) {
+    if (!viewCuller.enabled) return true;
+    const Bounds& w = viewCuller.window;
+    return b.maxX >= w.minX && b.minX <= w.maxX && b.maxY >= w.minY && b.minY <= w.maxY;
+}
+
+Bounds rectBounds(float x, float y, float w, float h) {
+    return { x, y, x + w, y + h };
+}
+
+Bounds unionBounds(const Bounds& a, const Bounds& b) {
+    return { std::min(a.minX, b.minX), std::min(a.minY, b.minY), std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY) };
+}
+
+// World box around a node-space box, from its four transformed corners
+Bounds transformBounds(const glm::mat3& m, const Bounds& local) {
+    const float corners[] = {
+        local.minX, local.minY, local.maxX, local.minY,
+        local.maxX, local.maxY, local.minX, local.maxY };
+    float world[8];
+    for (int i = 0; i < 4; ++i) {
+        glm::vec3 p = m * glm::vec3(corners[i * 2], corners[i * 2 + 1], 1.0f);
+        world[i * 2] = p.x;
+        world[i * 2 + 1] = p.y;
+    }
+    return pointBounds(world, 4);
+}
+
+// ----------------- Scene Graph -----------------
+// The articulated props (sail boat, palm trees, umbrella, players and ball)
+// are a flat array of nodes, each parent ahead of its children, with local
+// 2D transforms as glm::mat3. One forward pass composes the world
+// transforms, then each prop's shapes are transformed on the CPU into a
+// batch of world-space triangles and lines. Batches are drawn under the
+// scene's identity modelview, so no matrix push/pop reaches the renderer,
+// and building them needs no GL, so it runs on the worker pool.
+struct SceneNode {
+    int parent;
+    glm::mat3 local;
+    glm::mat3 world;
+};
+
+struct SceneGraph {
+    std::vector<SceneNode> nodes;
+};
+
+// Consecutive shapes with the same mode (and width, for lines) share a run
+struct BatchRun {
+    GLenum mode;
+    int first;
+    int count;
+    float lineWidth;
+};
+
+struct SceneBatch {
+    std::vector<float> positions;   // x, y, z
+    std::vector<float> colors;      // r, g, b, a
+    std::vector<float> normals;
+    std::vector<BatchRun> runs;
+    glm::vec4 color = glm::vec4(1.0f);
+};
+
+int addSceneNode(SceneGraph& graph, int parent, const glm::mat3& local) {
+    graph.nodes.push_back({ parent, local, local });
+    return (int)graph.nodes.size() - 1;
+}
+
+void updateWorldTransforms(SceneGraph& graph) {
+    for (SceneNode& node : graph.nodes) {
+        if (node.parent >= 0) node.world = graph.nodes[node.parent].world * node.local;
+    }
+}
+
+glm::mat3 translation2D(float x, float y) {
+    return glm::translate(glm::mat3(1.0f), glm::vec2(x, y));
+}
+
+void clearSceneBatch(SceneBatch& batch) {
+    batch.positions.clear();
+    batch.colors.clear();
+    batch.normals.clear();
+    batch.runs.clear();
+}
+
+void batchColor(SceneBatch& batch, float r, float g, float b) {
+    batch.color = glm::vec4(r, g, b, 1.0f);
+}
+
+// Appends n vertices in the current colour facing the viewer and returns a
+// pointer to their positions; the batch keeps its capacity between frames
+float* batchGrow(SceneBatch& batch, int n) {
+    size_t first = batch.positions.size() / 3;
+    batch.positions.resize((first + n) * 3);
+    batch.colors.resize((first + n) * 4);
+    batch.normals.resize((first + n) * 3);
+    float* c = batch.colors.data() + first * 4;
+    float* nrm = batch.normals.data() + first * 3;
+    for (int i = 0; i < n; ++i) {
+        c[i * 4 + 0] = batch.color.r;
+        c[i * 4 + 1] = batch.color.g;
+        c[i * 4 + 2] = batch.color.b;
+        c[i * 4 + 3] = batch.color.a;
+        nrm[i * 3 + 0] = 0.0f;
+        nrm[i * 3 + 1] = 0.0f;
+        nrm[i * 3 + 2] = 1.0f;
+    }
+    return batch.positions.data() + first * 3;
+}
+
+inline float* putVertex(float* out, const glm::mat3& m, float x, float y) {
+    out[0] = m[0][0] * x + m[1][0] * y + m[2][0];
+    out[1] = m[0][1] * x + m[1][1] * y + m[2][1];
+    out[2] = 0.0f;
+    return out + 3;
+}
+
+void batchRun(SceneBatch& batch, GLenum mode, int count, float lineWidth = 1.0f) {
+    if (!batch.runs.empty()) {
+        BatchRun& last = batch.runs.back();
+        if (last.mode == mode && last.lineWidth == lineWidth) {
+            last.count += count;
+            return;
+        }
+    }
+    int first = (int)(batch.positions.size() / 3) - count;
+    batch.runs.push_back({ mode, first, count, lineWidth });
+}
+
+// Convex outline (GL_POLYGON / GL_TRIANGLE_FAN order) as triangles
+void batchFan(SceneBatch& batch, const glm::mat3& m, const float* xy, int count) {
+    if (count < 3) return;
+    float* out = batchGrow(batch, (count - 2) * 3);
+    for (int i = 1; i + 1 < count; ++i) {
+        out = putVertex(out, m, xy[0], xy[1]);
+        out = putVertex(out, m, xy[i * 2], xy[i * 2 + 1]);
+        out = putVertex(out, m, xy[i * 2 + 2], xy[i * 2 + 3]);
+    }
+    batchRun(batch, GL_TRIANGLES, (count - 2) * 3);
+}
+
+void batchTriangle(SceneBatch& batch, const glm::mat3& m, float x0, float y0, float x1, float y1, float x2, float y2) {
+    float* out = batchGrow(batch, 3);
+    out = putVertex(out, m, x0, y0);
+    out = putVertex(out, m, x1, y1);
+    putVertex(out, m, x2, y2);
+    batchRun(batch, GL_TRIANGLES, 3);
+}
+
+void batchQuads(SceneBatch& batch, const glm::mat3& m, const float* xy, int count) {
+    int quads = count / 4;
+    float* out = batchGrow(batch, quads * 6);
+    for (int q = 0; q < quads; ++q) {
+        const float* v = xy + q * 8;
+        out = putVertex(out, m, v[0], v[1]);
+        out = putVertex(out, m, v[2], v[3]);
+        out = putVertex(out, m, v[4], v[5]);
+        out = putVertex(out, m, v[0], v[1]);
+        out = putVertex(out, m, v[4], v[5]);
+        out = putVertex(out, m, v[6], v[7]);
+    }
+    batchRun(batch, GL_TRIANGLES, quads * 6);
+}
+
+void batchRect(SceneBatch& batch, const glm::mat3& m, float x, float y, float w, float h) {
+    const float quad[] = { x, y, x + w, y, x + w, y + h, x, y + h };
+    batchQuads(batch, m, quad, 4);
+}
+
+// Segment count follows myFilledEllipse, so LOD matches the live shapes
+void batchEllipse(SceneBatch& batch, const glm::mat3& m, float cx, float cy, float rx, float ry, int n = 48) {
+    const std::vector<float>& unit = getUnitCircle(circleSegments(std::max(fabsf(rx), fabsf(ry)), n));
+    int count = (int)unit.size() / 2;
+    float* out = batchGrow(batch, (count - 2) * 3);
+    for (int i = 1; i + 1 < count; ++i) {
+        out = putVertex(out, m, cx, cy);
+        out = putVertex(out, m, cx + unit[i * 2] * rx, cy + unit[i * 2 + 1] * ry);
+        out = putVertex(out, m, cx + unit[i * 2 + 2] * rx, cy + unit[i * 2 + 3] * ry);
+    }
+    batchRun(batch, GL_TRIANGLES, (count - 2) * 3);
+}
+
+void batchCircle(SceneBatch& batch, const glm::mat3& m, float cx, float cy, float r, int n = 48) {
+    batchEllipse(batch, m, cx, cy, r, r, n);
+}
+
+void batchLineStrip(SceneBatch& batch, const glm::mat3& m, const float* xy, int count, float width) {
+    float* out = batchGrow(batch, (count - 1) * 2);
+    for (int i = 0; i + 1 < count; ++i) {
+        out = putVertex(out, m, xy[i * 2], xy[i * 2 + 1]);
+        out = putVertex(out, m, xy[i * 2 + 2], xy[i * 2 + 3]);
+    }
+    batchRun(batch, GL_LINES, (count - 1) * 2, width);
+}
+
+void drawSceneBatch(const SceneBatch& batch) {
+    for (const BatchRun& run : batch.runs) {
+        if (run.mode == GL_LINES) gfx->lineWidth(run.lineWidth);
+        VertexArrays arrays;
+        arrays.positions = batch.positions.data() + run.first * 3;
+        arrays.positionSize = 3;
+        arrays.colors = batch.colors.data() + run.first * 4;
+        arrays.normals = batch.normals.data() + run.first * 3;
+        gfx->drawArrays(run.mode, run.count, arrays);
+    }
 }
 
 // ----------------- Scene Elements -----------------
 
-// Draw Stars
-void drawStars() {
-    if (!isNightMode) return;
-    glDisable(GL_LIGHTING);
-    glPointSize(2.0f);
-    glBegin(GL_POINTS);
-    glColor3f(1.0f, 1.0f, 1.0f);
-    for (const auto& p : stars) {
-        float twinkle = 0.7f + 0.3f * sinf(secs() * 2.0f + p.x * 0.1f);
-        glColor4f(1.0f, 1.0f, 1.0f, twinkle);
-        glVertex2f(p.x, p.y);
+// Twinkle = 0.7 + 0.3 * sin(2t + 0.1x), expanded with the angle-sum identity
+// so only one sin/cos pair is evaluated per frame and the loop vectorizes.
+// Stars [begin, end) only, so the field can be split across workers.
+void updateStarTwinkle(float t, size_t begin, size_t end) {
+    float s = sinf(t * 2.0f);
+    float c = cosf(t * 2.0f);
+    const float* ps = stars.phaseSin.data();
+    const float* pc = stars.phaseCos.data();
+    GLubyte* col = stars.colors.data();
+    for (size_t i = begin; i < end; ++i) {
+        float twinkle = 0.7f + 0.3f * (s * pc[i] + c * ps[i]);
+        col[i * 4 + 3] = (GLubyte)(twinkle * 255.0f);
     }
-    glEnd();
-    if (isNightMode) glEnable(GL_LIGHTING);
+}
+
+void updateStarTwinkle(float t) {
+    updateStarTwinkle(t, 0, stars.phaseSin.size());
+}
+
+// Draw Stars, twinkled by prepareFrame
+void drawStars() {
+    if (!isNightMode || stars.phaseSin.empty()) return;
+
+    gfx->setLighting(false);
+    gfx->setBlend(true);
+    gfx->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    gfx->pointSize(2.0f);
+    VertexArrays arrays;
+    arrays.positions = stars.positions.data();
+    arrays.colors = stars.colors.data();
+    arrays.colorType = GL_UNSIGNED_BYTE;
+    gfx->drawArrays(GL_POINTS, stars.phaseSin.size(), arrays);
+    gfx->setBlend(false);
+    if (isNightMode) gfx->setLighting(true);
 }
 
 // Shooting Star Logic
-void drawShootingStar(float t) {
+void stepShootingStar(float t) {
     if (!isNightMode) { sStarActive = false; return; }
 
-    glDisable(GL_LIGHTING);
-    glEnable(GL_BLEND);
-
     if (!sStarActive) {
         if (t > sStarNextSpawnTime) {
+            // Start x, start y and the delay before the next one
+            float u[3];
+            glm::linearRand(0.0f, 1.0f, skySeed * 2 + 1, sStarSpawnCount * 3, u, 3);
             sStarActive = true;
-            sStarX = (float)(rand() % (WIN_W / 2) - 100);
-            sStarY = (float)(WIN_H + (rand() % 200));
+            sStarX = floorf(u[0] * (WIN_W / 2)) - 100.0f;
+            sStarY = WIN_H + floorf(u[1] * 200.0f);
+            sStarSpawnDelay = 3.0f + floorf(u[2] * 50.0f) / 10.0f;
+            ++sStarSpawnCount;
         }
     }
     else {
         sStarX += 3.5f;
         sStarY -= 2.0f;
 
-        glLineWidth(3.0f);
-        glBegin(GL_LINES);
-        glColor4f(1.0f, 1.0f, 1.0f, 0.0f);
-        glVertex2f(sStarX - 100, sStarY + 57.0f);
-        glColor4f(0.8f, 0.9f, 1.0f, 1.0f);
-        glVertex2f(sStarX, sStarY);
-        glEnd();
-
-        glPointSize(5.0f);
-        glBegin(GL_POINTS);
-        glColor3f(1.0f, 1.0f, 1.0f);
-        glVertex2f(sStarX, sStarY);
-        glEnd();
-
         if (sStarX > WIN_W + 200 || sStarY < -200) {
             sStarActive = false;
-            sStarNextSpawnTime = t + 3.0f + (rand() % 50) / 10.0f;
+            sStarNextSpawnTime = t + sStarSpawnDelay;
         }
     }
-    glDisable(GL_BLEND);
-    if (isNightMode) glEnable(GL_LIGHTING);
 }
 
-void drawCelestialBody(float cx, float cy, float coreR, float t) {
-    if (isNightMode) {
-        glDisable(GL_LIGHTING);
-        glEnable(GL_BLEND);
-        glColor4f(0.8f, 0.8f, 1.0f, 0.3f);
-        myFilledCircle(cx, cy, coreR * 1.15f, 64);
-        glDisable(GL_BLEND);
+Bounds shootingStarBounds() {
+    return { sStarX - 100.0f, sStarY, sStarX, sStarY + 57.0f };
+}
 
-        glColor3f(0.92f, 0.94f, 1.0f);
-        myFilledCircle(cx, cy, coreR, 64);
+void drawShootingStar() {
+    if (!isNightMode || !sStarActive || !isVisible(shootingStarBounds())) return;
 
-        glColor3f(0.85f, 0.87f, 0.95f);
-        myFilledCircle(cx - 15, cy + 10, 12, 32);
-        myFilledCircle(cx + 20, cy - 5, 8, 32);
-        myFilledCircle(cx - 5, cy - 18, 10, 32);
+    gfx->setLighting(false);
+    gfx->setBlend(true);
+
+    gfx->lineWidth(3.0f);
+    gfx->begin(GL_LINES);
+    gfx->color4f(1.0f, 1.0f, 1.0f, 0.0f);
+    gfx->vertex2f(sStarX - 100, sStarY + 57.0f);
+    gfx->color4f(0.8f, 0.9f, 1.0f, 1.0f);
+    gfx->vertex2f(sStarX, sStarY);
+    gfx->end();
+
+    gfx->pointSize(5.0f);
+    gfx->begin(GL_POINTS);
+    gfx->color3f(1.0f, 1.0f, 1.0f);
+    gfx->vertex2f(sStarX, sStarY);
+    gfx->end();
+
+    gfx->setBlend(false);
+    if (isNightMode) gfx->setLighting(true);
+}
+
+// Out to the widest halo ring at the peak of the daytime pulse
+Bounds celestialBounds(float cx, float cy, float coreR) {
+    float r = isNightMode ? coreR * 1.15f : coreR * (1.0f + 5.0f * 1.02f);
+    return { cx - r, cy - r, cx + r, cy + r };
+}
 
-        glEnable(GL_LIGHTING);
-        GLfloat lightPos[] = { cx, cy, 100.0f, 1.0f };
-        GLfloat lightColor[] = { 0.4f, 0.4f, 0.6f, 1.0f };
-        glLightfv(GL_LIGHT0, GL_POSITION, lightPos);
-        glLightfv(GL_LIGHT0, GL_DIFFUSE, lightColor);
+void drawCelestialHalo(float cx, float cy, float coreR, float t) {
+    gfx->setLighting(false);
+    if (isNightMode) {
+        gfx->setBlend(true);
+        gfx->color4f(0.8f, 0.8f, 1.0f, 0.3f);
+        myFilledCircle(cx, cy, coreR * 1.15f, 64);
+        gfx->setBlend(false);
     }
     else {
-        glDisable(GL_LIGHTING);
-
         float pulse = 0.98f + 0.04f * (0.5f + 0.5f * sinf(t * 0.8f));
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        gfx->setBlend(true);
+        gfx->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         for (int i = 5; i >= 1; --i) {
             float R = coreR + i * coreR * 1.0f * pulse;
             float a = 0.04f * (6 - i);
-            glColor4f(1.0f, 0.95f, 0.5f, a);
+            gfx->color4f(1.0f, 0.95f, 0.5f, a);
             myFilledCircle(cx, cy, R, 64);
         }
-        glDisable(GL_BLEND);
-        glColor3f(1.0f, 0.94f, 0.20f);
+        gfx->setBlend(false);
+    }
+}
+
+void drawCelestialCore(float cx, float cy, float coreR) {
+    if (isNightMode) {
+        gfx->color3f(0.92f, 0.94f, 1.0f);
+        myFilledCircle(cx, cy, coreR, 64);
+
+        gfx->color3f(0.85f, 0.87f, 0.95f);
+        myFilledCircle(cx - 15, cy + 10, 12, 32);
+        myFilledCircle(cx + 20, cy - 5, 8, 32);
+        myFilledCircle(cx - 5, cy - 18, 10, 32);
+    }
+    else {
+        gfx->color3f(1.0f, 0.94f, 0.20f);
         myFilledCircle(cx, cy, coreR, 64);
     }
 }
 
-void drawCloud(float x, float y, float scale, float t) {
-    float drift = x + t * 8.0f;
-    float bob = sinf(t * 0.6f + x * 0.01f) * 5.0f;
-    float Y = y + bob;
+// At night the moon is the scene's light source for everything drawn after it
+const float MOON_LIGHT_HEIGHT = 100.0f;
+const GLfloat moonLightColor[] = { 0.4f, 0.4f, 0.6f, 1.0f };
+
+void enableMoonLight(float cx, float cy) {
+    gfx->setLighting(true);
+    GLfloat lightPos[] = { cx, cy, MOON_LIGHT_HEIGHT, 1.0f };
+    gfx->setLight(lightPos, moonLightColor);
+}
+
+// What the moon light gives a flat, front-facing surface at (x, y), for
+// geometry that is drawn unlit
+void moonLightTint(float x, float y, float rgb[3]) {
+    float dx = CELESTIAL_X - x, dy = CELESTIAL_Y - y;
+    float nDotL = MOON_LIGHT_HEIGHT / sqrtf(dx * dx + dy * dy + MOON_LIGHT_HEIGHT * MOON_LIGHT_HEIGHT);
+    for (int k = 0; k < 3; ++k) rgb[k] = std::min(0.2f + moonLightColor[k] * nDotL, 1.0f);
+}
+
+void drawCelestialBody(float cx, float cy, float coreR, float t) {
+    drawCelestialHalo(cx, cy, coreR, t);
+    drawCelestialCore(cx, cy, coreR);
+    if (isNightMode) enableMoonLight(cx, cy);
+}
+
+void drawCloudShape(const CloudShape& shape, float cx, float cy, float scale) {
+    for (const CloudPuff& p : shape.puffs) {
+        myFilledCircle(cx + p.dx * scale, cy + p.dy * scale, p.r * scale, p.segments);
+    }
+    myFilledRect(cx + shape.rectX * scale, cy + shape.rectY * scale, shape.rectW * scale, shape.rectH * scale);
+}
+
+// Drift wraps over a span wide enough for the largest cloud to leave the
+// screen completely before it comes back on the other side
+void cloudPosition(const Cloud& cloud, float t, float& x, float& y) {
+    const CloudLayer& layer = cloudLayers[cloud.layer];
+    float margin = CLOUD_BOX_W * 1.5f;
+    float span = WIN_W + 2.0f * margin;
+    x = fmodf(cloud.x + margin + t * layer.speed, span) - margin;
+    y = cloud.y + sinf(t * 0.6f + cloud.x * 0.01f) * layer.bobAmplitude;
+}
 
-    if (isNightMode) glColor3f(0.4f, 0.4f, 0.5f);
-    else glColor3f(1.0f, 1.0f, 1.0f);
+// Live fallback when there is no cloud atlas; layer fading needs the atlas
+void drawCloud(const Cloud& cloud, float t) {
+    float x, y;
+    cloudPosition(cloud, t, x, y);
+    if (!isVisible(rectBounds(x + CLOUD_BOX_LEFT * cloud.scale, y + CLOUD_BOX_BOTTOM * cloud.scale,
+        CLOUD_BOX_W * cloud.scale, CLOUD_BOX_H * cloud.scale))) return;
+    if (isNightMode) gfx->color3f(0.4f, 0.4f, 0.5f);
+    else gfx->color3f(1.0f, 1.0f, 1.0f);
+    drawCloudShape(cloudShapes[cloud.shape], x, y, cloud.scale);
+}
 
-    myFilledCircle(drift, Y, 45.0f * scale, 50);
-    myFilledCircle(drift - 55.0f * scale, Y - 10.0f * scale, 40.0f * scale, 45);
-    myFilledCircle(drift + 40.0f * scale, Y - 15.0f * scale, 35.0f * scale, 45);
-    myFilledCircle(drift - 35.0f * scale, Y - 25.0f * scale, 25.0f * scale, 36);
-    myFilledCircle(drift + 25.0f * scale, Y - 28.0f * scale, 28.0f * scale, 36);
+void buildOceanBasis(OceanSurface& surface, const OceanSettings& settings, float top, float bottom) {
+    int cols = settings.columns, rows = settings.rows;
+    int octaves = std::min(settings.octaves, OCEAN_MAX_OCTAVES);
+    surface.built = settings;
+    surface.vertexCount = (cols + 1) * (rows + 1);
+    surface.baseX.resize(surface.vertexCount);
+    surface.baseY.resize(surface.vertexCount);
+    surface.basisSin.assign(octaves * surface.vertexCount, 0.0f);
+    surface.basisCos.assign(octaves * surface.vertexCount, 0.0f);
+    surface.heights.assign(surface.vertexCount, 0.0f);
+    surface.amplitudeSum = 0.0f;
+    for (int k = 0; k < octaves; ++k) surface.amplitudeSum += oceanWaveAmplitude[k];
+
+    for (int r = 0; r <= rows; ++r) {
+        // The shore row stays put so the sand edge never shows sky
+        float amplitudeScale = (r == rows) ? 0.0f : 1.0f;
+        for (int i = 0; i <= cols; ++i) {
+            int v = r * (cols + 1) + i;
+            float x = WIN_W * (float)i / cols;
+            surface.baseX[v] = x;
+            surface.baseY[v] = top + (bottom - top) * r / rows;
+            for (int k = 0; k < octaves; ++k) {
+                float phase = x * 2.0f * PI / oceanWaveLength[k] + r * oceanRowPhase[k];
+                float amp = oceanWaveAmplitude[k] * amplitudeScale;
+                surface.basisSin[k * surface.vertexCount + v] = amp * sinf(phase);
+                surface.basisCos[k * surface.vertexCount + v] = amp * cosf(phase);
+            }
+        }
+    }
+    surface.lastT = -1.0f;
+    surface.valid = true;
+}
 
-    if (isNightMode) glColor4f(0.4f, 0.4f, 0.5f, 0.6f);
-    else glColor4f(1.0f, 1.0f, 1.0f, 0.6f);
-    myFilledRect(drift - 60.0f * scale, Y - 35.0f * scale, 120.0f * scale, 20.0f * scale);
+// h = sum of a * sin(phase + w t), expanded with the angle-sum identity
+void updateOceanHeights(OceanSurface& surface, float t) {
+    if (t == surface.lastT) return;
+    surface.lastT = t;
+    int n = surface.vertexCount;
+    int octaves = (int)(surface.basisSin.size() / std::max(n, 1));
+    float* h = surface.heights.data();
+    std::fill(surface.heights.begin(), surface.heights.end(), 0.0f);
+    for (int k = 0; k < octaves; ++k) {
+        float s = sinf(t * oceanWaveSpeed[k]);
+        float c = cosf(t * oceanWaveSpeed[k]);
+        const float* bs = surface.basisSin.data() + k * n;
+        const float* bc = surface.basisCos.data() + k * n;
+        for (int v = 0; v < n; ++v) h[v] += bs[v] * c + bc[v] * s;
+    }
 }
 
-void drawWaveLines(float left, float right, float baseY, float t) {
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glLineWidth(3.0f);
-    glNormal3f(0, 0, 1);
-    for (int i = 0; i < 3; ++i) {
-        float offset = baseY + i * 25.0f + 10.0f;
-        float amp = 4.0f - i * 1.0f;
-        float speed = 0.15f + i * 0.03f;
-        glColor4f(1.0f, 1.0f, 1.0f, 0.25f);
-        glBegin(GL_LINE_STRIP);
-        for (float x = left; x <= right; x += 8.0f) {
-            float nx = x / 90.0f;
-            float y = offset + sinf(nx + t * speed + i * 0.5f) * amp;
-            glVertex2f(x, y);
+// Gathers the displaced grid into one triangle strip and the crest lines.
+// Wave crests are shaded a little lighter than troughs.
+void buildOceanMesh(OceanSurface& surface, const float baseColor[3], const float crestColor[4]) {
+    int cols = surface.built.columns, rows = surface.built.rows;
+    float shadeScale = surface.amplitudeSum > 0.0f ? 0.15f / surface.amplitudeSum : 0.0f;
+    const float* h = surface.heights.data();
+
+    size_t stripCount = rows * (cols + 1) * 2 + (rows - 1) * 2;
+    surface.stripVertices.resize(stripCount * 2);
+    surface.stripColors.resize(stripCount * 4);
+    float* pos = surface.stripVertices.data();
+    float* col = surface.stripColors.data();
+    auto emit = [&](int v) {
+        float shade = 1.0f + h[v] * shadeScale;
+        *pos++ = surface.baseX[v];
+        *pos++ = surface.baseY[v] + h[v];
+        *col++ = baseColor[0] * shade;
+        *col++ = baseColor[1] * shade;
+        *col++ = baseColor[2] * shade;
+        *col++ = 1.0f;
+    };
+    for (int r = 0; r < rows; ++r) {
+        int top = r * (cols + 1), below = (r + 1) * (cols + 1);
+        if (r > 0) emit(top);
+        for (int i = 0; i <= cols; ++i) {
+            emit(top + i);
+            emit(below + i);
+        }
+        if (r + 1 < rows) emit(below + cols);
+    }
+
+    if (!surface.built.crestLines) {
+        surface.crestVertices.clear();
+        surface.crestColors.clear();
+        return;
+    }
+    size_t crestCount = rows * cols * 2;
+    surface.crestVertices.resize(crestCount * 2);
+    surface.crestColors.resize(crestCount * 4);
+    pos = surface.crestVertices.data();
+    col = surface.crestColors.data();
+    for (int r = 0; r < rows; ++r) {
+        float alpha = crestColor[3] * (1.0f - (float)r / rows);
+        for (int i = 0; i < cols; ++i) {
+            int v = r * (cols + 1) + i;
+            for (int e = 0; e < 2; ++e) {
+                *pos++ = surface.baseX[v + e];
+                *pos++ = surface.baseY[v + e] + h[v + e];
+                *col++ = crestColor[0];
+                *col++ = crestColor[1];
+                *col++ = crestColor[2];
+                *col++ = alpha;
+            }
         }
-        glEnd();
     }
-    glDisable(GL_BLEND);
 }
 
-void drawOceanBase(float left, float right, float top, float bottom, float t) {
-    if (isNightMode) glColor3f(0.01f, 0.15f, 0.25f);
-    else glColor3f(0.02f, 0.62f, 0.78f);
+// Crests can rise above the top row by every octave's amplitude at once
+Bounds oceanBounds() {
+    float rise = 0.0f;
+    for (int k = 0; k < OCEAN_MAX_OCTAVES; ++k) rise += oceanWaveAmplitude[k];
+    return { 0.0f, SAND_TOP_Y, (float)WIN_W, OCEAN_TOP_Y + rise };
+}
+
+void prepareOcean(float t, bool night) {
+    const OceanSettings& built = ocean.built;
+    if (!ocean.valid || built.columns != oceanSettings.columns || built.rows != oceanSettings.rows
+        || built.octaves != oceanSettings.octaves || built.crestLines != oceanSettings.crestLines) {
+        buildOceanBasis(ocean, oceanSettings, OCEAN_TOP_Y, SAND_TOP_Y);
+    }
+    updateOceanHeights(ocean, t);
+
+    const float dayColor[3] = { 0.02f, 0.62f, 0.78f };
+    const float nightColor[3] = { 0.01f, 0.15f, 0.25f };
+    const float dayCrest[4] = { 1.0f, 1.0f, 1.0f, 0.35f };
+    const float nightCrest[4] = { 0.6f, 0.6f, 0.8f, 0.2f };
+    buildOceanMesh(ocean, night ? nightColor : dayColor, night ? nightCrest : dayCrest);
+}
 
-    myFilledRect(left, bottom, right - left, top - bottom);
-    drawWaveLines(left, right, (top + bottom) * 0.5f, t);
+// Mesh built by prepareFrame
+void drawOcean() {
+    gfx->normal3f(0, 0, 1);
+    VertexArrays arrays;
+    arrays.positions = ocean.stripVertices.data();
+    arrays.colors = ocean.stripColors.data();
+    gfx->drawArrays(GL_TRIANGLE_STRIP, ocean.stripVertices.size() / 2, arrays);
+
+    if (ocean.crestVertices.empty()) return;
+    gfx->setBlend(true);
+    gfx->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    gfx->lineWidth(1.5f);
+    VertexArrays crestArrays;
+    crestArrays.positions = ocean.crestVertices.data();
+    crestArrays.colors = ocean.crestColors.data();
+    gfx->drawArrays(GL_LINES, ocean.crestVertices.size() / 2, crestArrays);
+    gfx->setBlend(false);
 }
 
-void drawSailBoat(float cx, float cy, float t) {
+// Sail boat: one node, drifting across the horizon with a bob and a tilt
+const float BOAT_HULL_W = 80.0f;
+const float BOAT_HULL_H = 30.0f;
+const float BOAT_MAST_H = 130.0f;
+
+struct SailBoatRig {
+    int hull;
+};
+
+SailBoatRig addSailBoatNodes(SceneGraph& graph, float cy, float t) {
     float boatBob = sinf(t * 1.2f) * 4.0f;
     float boatTilt = sinf(t * 1.0f) * 2.0f;
     float boatSpeed = 70.0f;
@@ -353,137 +2573,131 @@ void drawSailBoat(float cx, float cy, float t) {
     float totalDistance = endX - startX;
     float boatX = startX + fmod(t * boatSpeed, totalDistance);
 
-    glPushMatrix();
-    glTranslatef(boatX, cy + boatBob, 0.0f);
-    glRotatef(boatTilt, 0.0f, 0.0f, 1.0f);
+    SailBoatRig rig;
+    rig.hull = addSceneNode(graph, -1, glm::rotate(translation2D(boatX, cy + boatBob), glm::radians(boatTilt)));
+    return rig;
+}
+
+// Half the time the boat is out in the margin beyond either edge
+Bounds sailBoatBounds(const SceneGraph& graph, const SailBoatRig& rig) {
+    return transformBounds(graph.nodes[rig.hull].world, { -BOAT_HULL_W, -BOAT_HULL_H, BOAT_HULL_W, BOAT_MAST_H });
+}
 
-    float hullW = 80.0f;
-    float hullH = 30.0f;
+void buildSailBoat(const SceneGraph& graph, const SailBoatRig& rig, SceneBatch& batch) {
+    const glm::mat3& m = graph.nodes[rig.hull].world;
+    float hullW = BOAT_HULL_W;
+    float hullH = BOAT_HULL_H;
 
-    glNormal3f(0, 0, 1);
-    glColor3f(0.45f, 0.25f, 0.05f);
-    glBegin(GL_POLYGON);
+    batchColor(batch, 0.45f, 0.25f, 0.05f);
+    float hull[41 * 2];
     for (int i = 0; i <= 40; ++i) {
         float a = PI + (float)i / 40.0f * PI;
-        glVertex2f(cosf(a) * hullW, sinf(a) * hullH);
+        hull[i * 2] = cosf(a) * hullW;
+        hull[i * 2 + 1] = sinf(a) * hullH;
     }
-    glEnd();
+    batchFan(batch, m, hull, 41);
 
-    glColor3f(0.55f, 0.32f, 0.10f);
-    myFilledRect(-hullW, 0.0f, hullW * 2.0f, 10.0f);
+    batchColor(batch, 0.55f, 0.32f, 0.10f);
+    batchRect(batch, m, -hullW, 0.0f, hullW * 2.0f, 10.0f);
 
-    float mastH = 130.0f;
-    glColor3f(0.35f, 0.20f, 0.05f);
-    myFilledRect(-3.0f, 0.0f, 6.0f, mastH);
+    float mastH = BOAT_MAST_H;
+    batchColor(batch, 0.35f, 0.20f, 0.05f);
+    batchRect(batch, m, -3.0f, 0.0f, 6.0f, mastH);
 
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glBegin(GL_TRIANGLES);
-    glVertex2f(3.0f, 5.0f);
-    glVertex2f(3.0f, mastH - 10.0f);
-    glVertex2f(65.0f, 15.0f);
-    glEnd();
+    batchColor(batch, 1.0f, 1.0f, 1.0f);
+    batchTriangle(batch, m, 3.0f, 5.0f, 3.0f, mastH - 10.0f, 65.0f, 15.0f);
 
-    glColor3f(0.95f, 0.2f, 0.2f);
-    glBegin(GL_TRIANGLES);
-    glVertex2f(5.0f, 20.0f);
-    glVertex2f(5.0f, 55.0f);
-    glVertex2f(40.0f, 25.0f);
-    glEnd();
+    batchColor(batch, 0.95f, 0.2f, 0.2f);
+    batchTriangle(batch, m, 5.0f, 20.0f, 5.0f, 55.0f, 40.0f, 25.0f);
 
-    glColor3f(1.0f, 0.0f, 0.0f);
-    glBegin(GL_TRIANGLES);
-    glVertex2f(0.0f, mastH);
-    glVertex2f(18.0f, mastH - 4.0f);
-    glVertex2f(0.0f, mastH - 8.0f);
-    glEnd();
-    glPopMatrix();
+    batchColor(batch, 1.0f, 0.0f, 0.0f);
+    batchTriangle(batch, m, 0.0f, mastH, 18.0f, mastH - 4.0f, 0.0f, mastH - 8.0f);
 }
 
-void drawPalmTree(float baseX, float baseY, float t, bool smallTree = false) {
-    glPushMatrix();
-    glTranslatef(baseX, baseY, 0.0f);
-
-    float trunkH = smallTree ? 180.0f : 250.0f;
-
-    if (!smallTree) {
-        glEnableClientState(GL_VERTEX_ARRAY);
-        glEnableClientState(GL_COLOR_ARRAY);
-        glEnableClientState(GL_NORMAL_ARRAY);
-
-        glVertexPointer(3, GL_FLOAT, 0, treeTrunkVertices.data());
-        glColorPointer(3, GL_FLOAT, 0, treeTrunkColors.data());
-        glNormalPointer(GL_FLOAT, 0, treeTrunkNormals.data());
-
-        glDrawArrays(GL_TRIANGLES, 0, treeTrunkVertices.size() / 3);
-
-        glDisableClientState(GL_NORMAL_ARRAY);
-        glDisableClientState(GL_COLOR_ARRAY);
-        glDisableClientState(GL_VERTEX_ARRAY);
-    }
-    else {
-        float trunkW = 40.0f;
-        glColor3f(0.54f, 0.32f, 0.12f);
-        glNormal3f(0, 0, 1);
-        glBegin(GL_QUADS);
-        for (int i = 0; i < 10; ++i) {
-            float y0 = trunkH * i / 10.0f;
-            float y1 = trunkH * (i + 1) / 10.0f;
-            float w0 = trunkW * (1.0f - i * 0.05f);
-            float w1 = trunkW * (1.0f - (i + 1) * 0.05f);
-            float offsetX0 = powf((float)i / 10.0f, 2.0f) * 18.0f;
-            float offsetX1 = powf((float)(i + 1) / 10.0f, 2.0f) * 18.0f;
-            glVertex2f(-w0 * 0.5f + offsetX0, y0);
-            glVertex2f(w0 * 0.5f + offsetX0, y0);
-            glVertex2f(w1 * 0.5f + offsetX1, y1);
-            glVertex2f(-w1 * 0.5f + offsetX1, y1);
-        }
-        glEnd();
-    }
+// Palm tree: one node at the base; the fronds are swayed beforehand
+struct PalmTreeRig {
+    int base;
+    bool smallTree;
+};
+
+PalmTreeRig addPalmTreeNodes(SceneGraph& graph, float baseX, float baseY, bool smallTree) {
+    PalmTreeRig rig;
+    rig.base = addSceneNode(graph, -1, translation2D(baseX, baseY));
+    rig.smallTree = smallTree;
+    return rig;
+}
 
-    float topY = trunkH;
-    float topOffsetX = powf(1.0f, 2.0f) * 18.0f;
-    float leafLength = smallTree ? 100.0f : 150.0f;
-    float swayAmplitude = smallTree ? 5.0f : 6.0f;
-    glColor3f(0.08f, 0.55f, 0.18f);
+Bounds palmTreeBounds(const SceneGraph& graph, const PalmTreeRig& rig) {
+    const Bounds& trunk = rig.smallTree ? smallTreeTrunkBounds : treeTrunkBounds;
+    const Bounds& fronds = rig.smallTree ? smallFrondMesh.bounds : largeFrondMesh.bounds;
+    return transformBounds(graph.nodes[rig.base].world, unionBounds(trunk, fronds));
+}
 
-    glNormal3f(0, 0, 1);
-    for (int f = 0; f < 6; ++f) {
-        glPushMatrix();
-        float angle = 360.0f / 6.0f * f;
-        glTranslatef(topOffsetX, topY, 0.0f);
-        glRotatef(angle, 0.0f, 0.0f, 1.0f);
-        float sway = sinf(t * 1.8f + f) * swayAmplitude;
-        int leafSegments = 18;
-        for (int s = 0; s < leafSegments; ++s) {
-            float u = (float)s / (leafSegments - 1);
-            float stemX = leafLength * u;
-            float stemY = sinf(u * PI) * 10.0f;
-            int leaflets = 6;
-            for (int l = 0; l < leaflets; ++l) {
-                float leafletY = (l - leaflets / 2) * 6.0f * (1.0f - u);
-                float leafletLength = 24.0f * (1.0f - u) + 10.0f;
-                float leafletHeight = 8.0f;
-                glBegin(GL_QUADS);
-                glVertex2f(stemX, stemY + leafletY + sway * u);
-                glVertex2f(stemX + leafletLength, stemY + leafletY + sway * u);
-                glVertex2f(stemX + leafletLength, stemY + leafletY + leafletHeight + sway * u);
-                glVertex2f(stemX, stemY + leafletY + leafletHeight + sway * u);
-                glEnd();
+// The trunk's normals carry its shading and pass through unchanged, which
+// holds because the base node only translates
+void buildPalmTree(const SceneGraph& graph, const PalmTreeRig& rig, SceneBatch& batch) {
+    const glm::mat3& m = graph.nodes[rig.base].world;
+    float trunkH = rig.smallTree ? 180.0f : 250.0f;
+
+    if (!rig.smallTree) {
+        int count = (int)treeTrunkVertices.size() / 3;
+        float* out = batchGrow(batch, count);
+        size_t first = batch.positions.size() / 3 - count;
+        float* colors = batch.colors.data() + first * 4;
+        float* normals = batch.normals.data() + first * 3;
+        for (int i = 0; i < count; ++i) {
+            const float* v = &treeTrunkVertices[i * 3];
+            putVertex(out + i * 3, m, v[0], v[1]);
+            out[i * 3 + 2] = v[2];
+            for (int k = 0; k < 3; ++k) {
+                colors[i * 4 + k] = treeTrunkColors[i * 3 + k];
+                normals[i * 3 + k] = treeTrunkNormals[i * 3 + k];
             }
+            colors[i * 4 + 3] = 1.0f;
         }
-        glPopMatrix();
+        batchRun(batch, GL_TRIANGLES, count);
     }
+    else {
+        batchColor(batch, 0.54f, 0.32f, 0.12f);
+        batchQuads(batch, m, smallTreeTrunkVertices.data(), (int)smallTreeTrunkVertices.size() / 2);
+    }
+
+    float topY = trunkH;
+    float topOffsetX = powf(1.0f, 2.0f) * 18.0f;
+    const FrondMesh& fronds = rig.smallTree ? smallFrondMesh : largeFrondMesh;
+
+    batchColor(batch, 0.08f, 0.55f, 0.18f);
+    batchQuads(batch, m, fronds.vertices.data(), (int)fronds.vertices.size() / 2);
+
+    batchColor(batch, 0.2f, 0.12f, 0.02f);
+    batchCircle(batch, m, topOffsetX + 10.0f, topY - 8.0f, 9.0f, 24);
+    batchCircle(batch, m, topOffsetX - 10.0f, topY - 14.0f, 8.0f, 24);
+    batchCircle(batch, m, topOffsetX + 26.0f, topY - 18.0f, 7.0f, 24);
+}
 
-    glColor3f(0.2f, 0.12f, 0.02f);
-    myFilledCircle(topOffsetX + 10.0f, topY - 8.0f, 9.0f, 24);
-    myFilledCircle(topOffsetX - 10.0f, topY - 14.0f, 8.0f, 24);
-    myFilledCircle(topOffsetX + 26.0f, topY - 18.0f, 7.0f, 24);
+// Umbrella: one node at the foot of the pole, leaning
+struct UmbrellaRig {
+    int pole;
+    float r;
+};
+
+UmbrellaRig addUmbrellaNodes(SceneGraph& graph, float cx, float cy, float r, float leanAngle = -12.0f) {
+    UmbrellaRig rig;
+    rig.r = r * 1.25f;
+    float poleHeight = rig.r * 2.2f;
+    rig.pole = addSceneNode(graph, -1, glm::rotate(translation2D(cx, cy - poleHeight), glm::radians(leanAngle)));
+    return rig;
+}
 
-    glPopMatrix();
+Bounds umbrellaBounds(const SceneGraph& graph, const UmbrellaRig& rig) {
+    float canopyRadius = rig.r * 1.3f;
+    float top = rig.r * (2.2f + 0.9f + 0.08f * 1.6f);
+    return transformBounds(graph.nodes[rig.pole].world, { -canopyRadius, 0.0f, canopyRadius, top });
 }
 
-void drawUmbrella(float cx, float cy, float r, float leanAngle = -12.0f) {
-    r *= 1.25f;
+void buildUmbrella(const SceneGraph& graph, const UmbrellaRig& rig, SceneBatch& batch) {
+    const glm::mat3& m = graph.nodes[rig.pole].world;
+    float r = rig.r;
     float poleHeight = r * 2.2f;
     float poleWidth = r * 0.12f;
     float canopyRadius = r * 1.3f;
@@ -493,218 +2707,186 @@ void drawUmbrella(float cx, float cy, float r, float leanAngle = -12.0f) {
     float knobRadius = r * 0.08f;
     int numPanels = 8;
 
-    glPushMatrix();
-    glTranslatef(cx, cy - poleHeight, 0);
-    glRotatef(leanAngle, 0, 0, 1);
-
-    glColor3f(0.45f, 0.28f, 0.05f);
-    myFilledRect(-poleWidth * 0.5f, 0, poleWidth, poleHeight);
+    batchColor(batch, 0.45f, 0.28f, 0.05f);
+    batchRect(batch, m, -poleWidth * 0.5f, 0, poleWidth, poleHeight);
 
     float step = 2.0f * PI / numPanels;
-    glNormal3f(0, 0, 1);
     for (int i = 0; i < numPanels; ++i) {
-        if (i % 2 == 0) glColor3f(1.0f, 0.25f, 0.25f);
-        else glColor3f(1.0f, 0.9f, 0.2f);
+        if (i % 2 == 0) batchColor(batch, 1.0f, 0.25f, 0.25f);
+        else batchColor(batch, 1.0f, 0.9f, 0.2f);
         float angle1 = i * step;
         float angle2 = (i + 1) * step;
-        glBegin(GL_TRIANGLES);
-        glVertex2f(0, canopyApexY_rel);
-        glVertex2f(cosf(angle1) * canopyRadius, canopyBottomY_rel);
-        glVertex2f(cosf(angle2) * canopyRadius, canopyBottomY_rel);
-        glEnd();
+        batchTriangle(batch, m, 0, canopyApexY_rel,
+            cosf(angle1) * canopyRadius, canopyBottomY_rel,
+            cosf(angle2) * canopyRadius, canopyBottomY_rel);
     }
 
-    glBegin(GL_POLYGON);
-    glColor3f(1.0f, 0.3f, 0.3f);
-    int segs = 60;
+    batchColor(batch, 1.0f, 0.3f, 0.3f);
+    const int segs = 60;
+    float rim[(segs + 1) * 2];
     for (int i = 0; i <= segs; ++i) {
         float a = PI + (float)i / segs * PI;
-        float x = cosf(a) * canopyRadius;
-        float y = canopyBottomY_rel;
-        glVertex2f(x, y);
+        rim[i * 2] = cosf(a) * canopyRadius;
+        rim[i * 2 + 1] = canopyBottomY_rel;
     }
-    glEnd();
+    batchFan(batch, m, rim, segs + 1);
 
-    glColor3f(1.0f, 0.9f, 0.2f);
-    myFilledCircle(0, canopyApexY_rel + knobRadius * 0.6f, knobRadius, 24);
-
-    glPopMatrix();
+    batchColor(batch, 1.0f, 0.9f, 0.2f);
+    batchCircle(batch, m, 0, canopyApexY_rel + knobRadius * 0.6f, knobRadius, 24);
 }
 
 void drawSand(float topY) {
-    if (isNightMode) glColor3f(0.6f, 0.55f, 0.4f);
-    else glColor3f(0.96f, 0.88f, 0.63f);
+    if (isNightMode) gfx->color3f(0.6f, 0.55f, 0.4f);
+    else gfx->color3f(0.96f, 0.88f, 0.63f);
     myFilledRect(0.0f, 0.0f, WIN_W, topY);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glPointSize(2.0f);
-    glBegin(GL_POINTS);
-    glColor4f(0.75f, 0.64f, 0.42f, 0.3f);
-    static bool seeded = false;
-    if (!seeded) { srand(12345); seeded = true; }
-    for (int i = 0; i < 1500; ++i) {
-        float rx = (float)(rand() % WIN_W);
-        float ry = (float)(rand() % (int)(topY - 10));
-        glVertex2f(rx, ry);
-    }
-    glEnd();
-    glDisable(GL_BLEND);
-}
-
-void drawVolleyball(float x, float y, float radius) {
-    glColor3f(1.0f, 1.0f, 1.0f);
-    myFilledCircle(x, y, radius);
-
-    glColor3f(0.3f, 0.3f, 0.3f);
-    glLineWidth(2.0f);
-    glPushMatrix();
-    glTranslatef(x, y, 0);
-
-    glNormal3f(0, 0, 1);
-    glBegin(GL_LINE_STRIP);
+    if (topY != sandGrainTopY) initSandGrains(topY);
+    if (sandGrainVertices.empty()) return;
+
+    gfx->setBlend(true);
+    gfx->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    gfx->pointSize(2.0f);
+    VertexArrays arrays;
+    arrays.positions = sandGrainVertices.data();
+    arrays.colors = isNightMode ? sandGrainColorsNight.data() : sandGrainColorsDay.data();
+    gfx->drawArrays(GL_POINTS, sandGrainVertices.size() / 2, arrays);
+    gfx->setBlend(false);
+}
+
+void buildVolleyballSeam(float radius, std::vector<float>& out) {
+    out.clear();
     for (int i = 0; i <= 16; ++i) {
         float a = -PI / 2 + (float)i / 16 * PI;
-        glVertex2f(cosf(a) * radius * 0.8f, sinf(a) * radius);
-    }
-    glEnd();
-
-    for (int j = 0; j < 2; ++j) {
-        glPushMatrix();
-        glRotatef(120.0f * (j + 1), 0, 0, 1);
-        glBegin(GL_LINE_STRIP);
-        for (int i = 0; i <= 16; ++i) {
-            float a = -PI / 2 + (float)i / 16 * PI;
-            glVertex2f(cosf(a) * radius * 0.8f, sinf(a) * radius);
-        }
-        glEnd();
-        glPopMatrix();
+        out.insert(out.end(), { cosf(a) * radius * 0.8f, sinf(a) * radius });
     }
-    glPopMatrix();
 }
 
-void drawGirlHair() {
-    glColor3f(0.3f, 0.2f, 0.1f);
-    myFilledEllipse(0, 10, 12, 8);
-    myFilledEllipse(-6, 8, 3, 6);
-    myFilledEllipse(6, 8, 3, 6);
+// Players: body node (position, breathing squash), arms pivoting at the
+// shoulders towards the ball, and the head carrying the hair
+struct PlayerRig {
+    int body;
+    int armR;
+    int armL;
+    int head;
+    float headY;
+};
+
+PlayerRig addPlayerNodes(SceneGraph& graph, float x, float y, float shoulderY, float headY,
+    float ballX, float ballY, float prevAngleR, float prevAngleL, float breatheScale) {
+    float angleRight = atan2(ballY - (y + shoulderY), ballX - (x + 14)) * 180 / PI;
+    float angleLeft = atan2(ballY - (y + shoulderY), ballX - (x - 14)) * 180 / PI;
+    float armR = lerp(prevAngleR, angleRight, 0.2f);
+    float armL = lerp(prevAngleL, angleLeft, 0.2f);
 
-    glNormal3f(0, 0, 1);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex2f(8, 5);
-    glVertex2f(14, 8);
-    glVertex2f(16, 12);
-    glVertex2f(14, 16);
-    glVertex2f(10, 18);
-    glVertex2f(8, 14);
-    glVertex2f(6, 10);
-    glEnd();
+    PlayerRig rig;
+    rig.body = addSceneNode(graph, -1,
+        glm::scale(translation2D(x, y), glm::vec2(1.0f + (1.0f - breatheScale) * 0.05f, breatheScale)));
+    rig.armR = addSceneNode(graph, rig.body, glm::rotate(translation2D(14, shoulderY), glm::radians(armR)));
+    rig.armL = addSceneNode(graph, rig.body, glm::rotate(translation2D(-14, shoulderY), glm::radians(armL)));
+    rig.head = addSceneNode(graph, rig.body, translation2D(0, headY));
+    rig.headY = headY;
+    return rig;
 }
 
-void drawBoyHair() {
-    glColor3f(0.2f, 0.15f, 0.1f);
-    myFilledEllipse(0, 10, 12, 7);
-    myFilledEllipse(-5, 8, 3, 5);
-    myFilledEllipse(5, 8, 3, 5);
-    myFilledEllipse(0, 6, 10, 3);
+// In body space: legs down to -45, arms swinging 30 from shoulders 14 out,
+// hair up to 20 above the head node
+Bounds playerBounds(const SceneGraph& graph, const PlayerRig& rig) {
+    return transformBounds(graph.nodes[rig.body].world, { -48.0f, -45.0f, 48.0f, rig.headY + 20.0f });
 }
 
-void drawGirlPlayer(float x, float y, float ballX, float ballY, float prevAngleR, float prevAngleL, float breatheScale) {
-    glPushMatrix();
-    glTranslatef(x, y, 0);
-    glScalef(1.0f + (1.0f - breatheScale) * 0.05f, breatheScale, 1.0f);
-
-    glColor3f(0.95f, 0.8f, 0.7f);
-    myFilledRect(-8, -40, 6, 40);
-    myFilledRect(2, -40, 6, 40);
-
-    glColor3f(0.9f, 0.2f, 0.4f);
-    myFilledRect(-12, 0, 24, 40);
+void buildGirlPlayer(const SceneGraph& graph, const PlayerRig& rig, SceneBatch& batch) {
+    const glm::mat3& body = graph.nodes[rig.body].world;
+    batchColor(batch, 0.95f, 0.8f, 0.7f);
+    batchRect(batch, body, -8, -40, 6, 40);
+    batchRect(batch, body, 2, -40, 6, 40);
+
+    batchColor(batch, 0.9f, 0.2f, 0.4f);
+    batchRect(batch, body, -12, 0, 24, 40);
+
+    batchColor(batch, 0.95f, 0.8f, 0.7f);
+    batchRect(batch, graph.nodes[rig.armR].world, -4, 0, 8, 30);
+    batchRect(batch, graph.nodes[rig.armL].world, -4, 0, 8, 30);
+
+    batchRect(batch, body, -5, 40, 10, 6);
+    batchCircle(batch, body, 0, 52, 10);
+
+    const glm::mat3& head = graph.nodes[rig.head].world;
+    batchColor(batch, 0.3f, 0.2f, 0.1f);
+    batchEllipse(batch, head, 0, 10, 12, 8);
+    batchEllipse(batch, head, -6, 8, 3, 6);
+    batchEllipse(batch, head, 6, 8, 3, 6);
+    const float ponytail[] = { 8, 5, 14, 8, 16, 12, 14, 16, 10, 18, 8, 14, 6, 10 };
+    batchFan(batch, head, ponytail, 7);
+}
 
-    float angleRight = atan2(ballY - (y + 30), ballX - (x + 14)) * 180 / PI;
-    float angleLeft = atan2(ballY - (y + 30), ballX - (x - 14)) * 180 / PI;
-    float armR = lerp(prevAngleR, angleRight, 0.2f);
-    float armL = lerp(prevAngleL, angleLeft, 0.2f);
+void buildBoyPlayer(const SceneGraph& graph, const PlayerRig& rig, SceneBatch& batch) {
+    const glm::mat3& body = graph.nodes[rig.body].world;
+    batchColor(batch, 0.9f, 0.75f, 0.65f);
+    batchRect(batch, body, -10, -45, 6, 45);
+    batchRect(batch, body, 4, -45, 6, 45);
 
-    glColor3f(0.95f, 0.8f, 0.7f);
-    glPushMatrix();
-    glTranslatef(14, 30, 0);
-    glRotatef(armR, 0, 0, 1);
-    myFilledRect(-4, 0, 8, 30);
-    glPopMatrix();
+    batchColor(batch, 0.2f, 0.6f, 0.9f);
+    batchRect(batch, body, -12, 0, 24, 20);
 
-    glPushMatrix();
-    glTranslatef(-14, 30, 0);
-    glRotatef(armL, 0, 0, 1);
-    myFilledRect(-4, 0, 8, 30);
-    glPopMatrix();
+    batchColor(batch, 0.9f, 0.75f, 0.65f);
+    batchRect(batch, body, -12, 20, 24, 30);
 
-    glColor3f(0.95f, 0.8f, 0.7f);
-    myFilledRect(-5, 40, 10, 6);
-    myFilledCircle(0, 52, 10);
+    batchRect(batch, graph.nodes[rig.armR].world, -4, 0, 8, 30);
+    batchRect(batch, graph.nodes[rig.armL].world, -4, 0, 8, 30);
 
-    glPushMatrix();
-    glTranslatef(0, 52, 0);
-    drawGirlHair();
-    glPopMatrix();
+    batchRect(batch, body, -5, 50, 10, 6);
+    batchCircle(batch, body, 0, 62, 10);
 
-    glPopMatrix();
+    const glm::mat3& head = graph.nodes[rig.head].world;
+    batchColor(batch, 0.2f, 0.15f, 0.1f);
+    batchEllipse(batch, head, 0, 10, 12, 7);
+    batchEllipse(batch, head, -5, 8, 3, 5);
+    batchEllipse(batch, head, 5, 8, 3, 5);
+    batchEllipse(batch, head, 0, 6, 10, 3);
 }
 
-void drawBoyPlayer(float x, float y, float ballX, float ballY, float prevAngleR, float prevAngleL, float breatheScale) {
-    glPushMatrix();
-    glTranslatef(x, y, 0);
-    glScalef(1.0f + (1.0f - breatheScale) * 0.05f, breatheScale, 1.0f);
-
-    glColor3f(0.9f, 0.75f, 0.65f);
-    myFilledRect(-10, -45, 6, 45);
-    myFilledRect(4, -45, 6, 45);
-
-    glColor3f(0.2f, 0.6f, 0.9f);
-    myFilledRect(-12, 0, 24, 20);
-
-    glColor3f(0.9f, 0.75f, 0.65f);
-    myFilledRect(-12, 20, 24, 30);
-
-    float angleRight = atan2(ballY - (y + 38), ballX - (x + 14)) * 180 / PI;
-    float angleLeft = atan2(ballY - (y + 38), ballX - (x - 14)) * 180 / PI;
-    float armR = lerp(prevAngleR, angleRight, 0.2f);
-    float armL = lerp(prevAngleL, angleLeft, 0.2f);
-
-    glColor3f(0.9f, 0.75f, 0.65f);
-    glPushMatrix();
-    glTranslatef(14, 38, 0);
-    glRotatef(armR, 0, 0, 1);
-    myFilledRect(-4, 0, 8, 30);
-    glPopMatrix();
+// Volleyball: a node at the ball's centre and one per seam, 120 degrees apart
+struct VolleyballRig {
+    int ball;
+    int seams[3];
+    float radius;
+};
+
+VolleyballRig addVolleyballNodes(SceneGraph& graph, float x, float y, float radius) {
+    VolleyballRig rig;
+    rig.ball = addSceneNode(graph, -1, translation2D(x, y));
+    for (int j = 0; j < 3; ++j) rig.seams[j] = addSceneNode(graph, rig.ball, glm::rotate(glm::mat3(1.0f), glm::radians(120.0f * j)));
+    rig.radius = radius;
+    return rig;
+}
 
-    glPushMatrix();
-    glTranslatef(-14, 38, 0);
-    glRotatef(armL, 0, 0, 1);
-    myFilledRect(-4, 0, 8, 30);
-    glPopMatrix();
+Bounds volleyballBounds(const SceneGraph& graph, const VolleyballRig& rig) {
+    const glm::mat3& m = graph.nodes[rig.ball].world;
+    return { m[2][0] - rig.radius, m[2][1] - rig.radius, m[2][0] + rig.radius, m[2][1] + rig.radius };
+}
 
-    glColor3f(0.9f, 0.75f, 0.65f);
-    myFilledRect(-5, 50, 10, 6);
-    myFilledCircle(0, 62, 10);
+void buildVolleyball(const SceneGraph& graph, const VolleyballRig& rig, SceneBatch& batch) {
+    static std::vector<float> seamVertices;
+    static float seamRadius = -1.0f;
+    if (rig.radius != seamRadius) {
+        buildVolleyballSeam(rig.radius, seamVertices);
+        seamRadius = rig.radius;
+    }
 
-    glPushMatrix();
-    glTranslatef(0, 62, 0);
-    drawBoyHair();
-    glPopMatrix();
+    batchColor(batch, 1.0f, 1.0f, 1.0f);
+    batchCircle(batch, graph.nodes[rig.ball].world, 0, 0, rig.radius);
 
-    glPopMatrix();
+    batchColor(batch, 0.3f, 0.3f, 0.3f);
+    for (int j = 0; j < 3; ++j) {
+        batchLineStrip(batch, graph.nodes[rig.seams[j]].world, seamVertices.data(), (int)seamVertices.size() / 2, 2.0f);
+    }
 }
 
-void drawVolleyballGame(float baseY, float t) {
-    // --- UPDATED GAME SPEED ---
-    static float prevGirlR = 0, prevGirlL = 0, prevBoyR = 0, prevBoyL = 0;
-
+void volleyballPosition(float baseY, float t, float& ballX, float& ballY) {
     // FASTER CYCLE: 2.2 seconds (vs 4.0 previously)
     float cycleTime = 2.2f;
 
     float phase = fmod(t, cycleTime) / cycleTime;
-    float ballX, ballY;
 
     if (phase < 0.5f) {
         float p = phase / 0.5f;
@@ -716,6 +2898,37 @@ void drawVolleyballGame(float baseY, float t) {
         ballX = 250 + (150 - 250) * p;
         ballY = baseY + 20 + sinf(p * PI) * 40;
     }
+}
+
+// Arms ease towards the ball from where they pointed on the previous tick
+void stepVolleyballArms(float baseY, float t) {
+    float ballX, ballY;
+    volleyballPosition(baseY, t, ballX, ballY);
+    prevGirlR = atan2(ballY - (baseY + 30), ballX - (150 + 14)) * 180 / PI;
+    prevGirlL = atan2(ballY - (baseY + 30), ballX - (150 - 14)) * 180 / PI;
+    prevBoyR = atan2(ballY - (baseY + 38), ballX - (250 + 14)) * 180 / PI;
+    prevBoyL = atan2(ballY - (baseY + 38), ballX - (250 - 14)) * 180 / PI;
+}
+
+// One batch per draw-queue item that shows a prop
+struct PropBatches {
+    SceneBatch sailBoat;
+    SceneBatch palmTrees;
+    SceneBatch volleyball;
+    SceneBatch umbrella;
+};
+static SceneGraph propGraph;
+static PropBatches propBatches;
+
+// Poses every prop for time t, composes the world transforms in one pass
+// and rebuilds the batches. Runs as a single prepareFrame job because the
+// frond sway and the unit-circle cache it reads aren't shared with others.
+void prepareProps(float t) {
+    float baseY = SAND_TOP_Y;
+
+    // --- UPDATED GAME SPEED ---
+    float ballX, ballY;
+    volleyballPosition(baseY, t, ballX, ballY);
 
     // --- FASTER BREATHING ---
     // Multiplier increased to 10.0f (was 5.0f) for higher energy
@@ -738,15 +2951,838 @@ void drawVolleyballGame(float baseY, float t) {
         breathe = 1.05f;
     }
 
-    drawGirlPlayer(150, baseY + girlJump, ballX, ballY, prevGirlR, prevGirlL, breathe);
-    drawBoyPlayer(250, baseY + boyJump, ballX, ballY, prevBoyR, prevBoyL, breathe);
+    SceneGraph& graph = propGraph;
+    graph.nodes.clear();
+    SailBoatRig boat = addSailBoatNodes(graph, OCEAN_TOP_Y + 30.0f, t);
+    PalmTreeRig bigPalm = addPalmTreeNodes(graph, 800.0f, baseY, false);
+    PalmTreeRig smallPalm = addPalmTreeNodes(graph, 650.0f, baseY, true);
+    PlayerRig girl = addPlayerNodes(graph, 150, baseY + girlJump, 30, 52, ballX, ballY, prevGirlR, prevGirlL, breathe);
+    PlayerRig boy = addPlayerNodes(graph, 250, baseY + boyJump, 38, 62, ballX, ballY, prevBoyR, prevBoyL, breathe);
+    VolleyballRig ball = addVolleyballNodes(graph, ballX, ballY, 12);
+    UmbrellaRig umbrella = addUmbrellaNodes(graph, umbX_global, baseY, 50.0f);
+    updateWorldTransforms(graph);
+
+    // Culled props leave their part of the batch empty, and an empty batch
+    // is not submitted
+    PropBatches& batches = propBatches;
+    clearSceneBatch(batches.sailBoat);
+    if (isVisible(sailBoatBounds(graph, boat))) buildSailBoat(graph, boat, batches.sailBoat);
+    clearSceneBatch(batches.palmTrees);
+    if (isVisible(palmTreeBounds(graph, bigPalm))) {
+        updateFrondMesh(largeFrondMesh, t);
+        buildPalmTree(graph, bigPalm, batches.palmTrees);
+    }
+    if (isVisible(palmTreeBounds(graph, smallPalm))) {
+        updateFrondMesh(smallFrondMesh, t);
+        buildPalmTree(graph, smallPalm, batches.palmTrees);
+    }
+    clearSceneBatch(batches.volleyball);
+    if (isVisible(playerBounds(graph, girl))) buildGirlPlayer(graph, girl, batches.volleyball);
+    if (isVisible(playerBounds(graph, boy))) buildBoyPlayer(graph, boy, batches.volleyball);
+    if (isVisible(volleyballBounds(graph, ball))) buildVolleyball(graph, ball, batches.volleyball);
+    clearSceneBatch(batches.umbrella);
+    if (isVisible(umbrellaBounds(graph, umbrella))) buildUmbrella(graph, umbrella, batches.umbrella);
+}
 
-    prevGirlR = atan2(ballY - (baseY + 30), ballX - (150 + 14)) * 180 / PI;
-    prevGirlL = atan2(ballY - (baseY + 30), ballX - (150 - 14)) * 180 / PI;
-    prevBoyR = atan2(ballY - (baseY + 38), ballX - (250 + 14)) * 180 / PI;
-    prevBoyL = atan2(ballY - (baseY + 38), ballX - (250 - 14)) * 180 / PI;
+// ----------------- Static Background -----------------
+// The sun/moon core and sand (with its grains) only change on a night-mode
+// toggle, zoom or resize, so they are rasterized once into a window-sized
+// texture with transparent sky. Each part is then composited back at its
+// original place in the draw order, which keeps the stars behind the moon and
+// the animated ocean's shore edge behind the sand.
+struct BackgroundCache {
+    bool enabled = true;
+    GLuint fbo = 0;
+    GLuint texture = 0;
+    int width = 0;
+    int height = 0;
+    bool valid = false;
+    bool night = false;
+    float zoom = 0.0f;
+    float viewLeft = 0, viewRight = 0, viewBottom = 0, viewTop = 0;
+};
+static BackgroundCache backgroundCache;
+
+bool backgroundCacheUsable() {
+    return backgroundCache.enabled && glExt.framebufferObject;
+}
+
+bool ensureBackgroundTarget(int w, int h) {
+    BackgroundCache& bg = backgroundCache;
+    if (bg.fbo && bg.width == w && bg.height == h) return true;
+
+    if (!bg.texture) glGenTextures(1, &bg.texture);
+    glBindTexture(GL_TEXTURE_2D, bg.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if (!bg.fbo) glExt.genFramebuffers(1, &bg.fbo);
+    glExt.bindFramebuffer(GL_FRAMEBUFFER, bg.fbo);
+    glExt.framebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, bg.texture, 0);
+    bool complete = glExt.checkFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glExt.bindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (!complete) {
+        std::cerr << "Background cache: framebuffer incomplete, drawing static layers live" << std::endl;
+        bg.enabled = false;
+        return false;
+    }
+    bg.width = w;
+    bg.height = h;
+    bg.valid = false;
+    return true;
+}
+
+// Expects the scene projection to be loaded and the modelview to be identity
+void updateBackgroundCache(float viewLeft, float viewRight, float viewBottom, float viewTop) {
+    BackgroundCache& bg = backgroundCache;
+    if (!ensureBackgroundTarget(viewportW, viewportH)) return;
+    if (bg.valid && bg.night == isNightMode && bg.zoom == globalZoom) return;
+
+    glExt.bindFramebuffer(GL_FRAMEBUFFER, bg.fbo);
+    glViewport(0, 0, bg.width, bg.height);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    gfx->setLighting(false);
+    drawCelestialCore(CELESTIAL_X, CELESTIAL_Y, CELESTIAL_R);
+    if (isNightMode) enableMoonLight(CELESTIAL_X, CELESTIAL_Y);
+    drawSand(SAND_TOP_Y);
+    gfx->setLighting(false);
+
+    glExt.bindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, viewportW, viewportH);
+
+    bg.valid = true;
+    bg.night = isNightMode;
+    bg.zoom = globalZoom;
+    bg.viewLeft = viewLeft;
+    bg.viewRight = viewRight;
+    bg.viewBottom = viewBottom;
+    bg.viewTop = viewTop;
+}
+
+// Copy a world-space rectangle of the cached layer back to the screen
+void compositeBackground(float x, float y, float w, float h) {
+    const BackgroundCache& bg = backgroundCache;
+    float u0 = (x - bg.viewLeft) / (bg.viewRight - bg.viewLeft);
+    float u1 = (x + w - bg.viewLeft) / (bg.viewRight - bg.viewLeft);
+    float v0 = (y - bg.viewBottom) / (bg.viewTop - bg.viewBottom);
+    float v1 = (y + h - bg.viewBottom) / (bg.viewTop - bg.viewBottom);
+    const float verts[] = { x, y, x + w, y, x + w, y + h, x, y + h };
+    const float texCoords[] = { u0, v0, u1, v0, u1, v1, u0, v1 };
+
+    gfx->setLighting(false);
+    gfx->setTexture(bg.texture);
+    gfx->setAlphaTest(true, 0.5f);
+
+    VertexArrays arrays;
+    arrays.positions = verts;
+    arrays.texCoords = texCoords;
+    gfx->drawArrays(GL_QUADS, 4, arrays);
+
+    gfx->setAlphaTest(false, 0.0f);
+    gfx->setTexture(0);
+    if (isNightMode) gfx->setLighting(true);
+}
+
+// ----------------- Cloud Atlas -----------------
+// Each cloud shape is rasterized once per palette (day row, night row) into
+// a texture atlas, and the whole cloud field is then one batch of tinted
+// sprites. Night tint comes from the moon light at the cloud's centre.
+struct CloudAtlas {
+    bool enabled = true;
+    GLuint fbo = 0;
+    GLuint texture = 0;
+    int cellW = 0;
+    int cellH = 0;
+    bool valid = false;
+    std::vector<SpriteInstance> sprites;
+};
+static CloudAtlas cloudAtlas;
+
+const float cloudDayColor[3] = { 1.0f, 1.0f, 1.0f };
+const float cloudNightColor[3] = { 0.4f, 0.4f, 0.5f };
+
+void initCloudField(int extraCount) {
+    clouds.clear();
+    // x, y, scale and shape of each cloud, from a fixed seed so the field is
+    // the same every run
+    std::vector<float> u(std::max(extraCount, 0) * 4);
+    glm::linearRand(0.0f, 1.0f, CLOUD_SEED, 0, u.data(), u.size());
+    const float* next = u.data();
+    for (int layer = 0; layer < CLOUD_LAYERS; ++layer) {
+        const CloudLayer& params = cloudLayers[layer];
+        for (int i = layer; i < extraCount; i += CLOUD_LAYERS, next += 4) {
+            Cloud cloud;
+            cloud.x = next[0] * WIN_W;
+            cloud.y = lerp(params.minY, params.maxY, next[1]);
+            cloud.scale = lerp(params.minScale, params.maxScale, next[2]);
+            cloud.shape = std::min((int)(next[3] * CLOUD_SHAPES), CLOUD_SHAPES - 1);
+            cloud.layer = layer;
+            clouds.push_back(cloud);
+        }
+    }
+    // The classic three, in front
+    const Cloud classic[] = {
+        { 200.0f, 600.0f, 1.0f, 0, CLOUD_LAYERS - 1 },
+        { 500.0f, 650.0f, 0.8f, 0, CLOUD_LAYERS - 1 },
+        { 850.0f, 620.0f, 1.2f, 0, CLOUD_LAYERS - 1 } };
+    clouds.insert(clouds.end(), std::begin(classic), std::end(classic));
+}
+
+bool cloudAtlasUsable() {
+    return cloudAtlas.enabled && glExt.framebufferObject;
+}
+
+bool buildCloudAtlas() {
+    CloudAtlas& atlas = cloudAtlas;
+    if (atlas.valid) return true;
+
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    atlas.cellW = maxTextureSize >= 2048 ? 512 : 256;
+    atlas.cellH = (int)(atlas.cellW * CLOUD_BOX_H / CLOUD_BOX_W);
+    int w = atlas.cellW * CLOUD_SHAPES, h = atlas.cellH * 2;
+
+    if (!atlas.texture) glGenTextures(1, &atlas.texture);
+    glBindTexture(GL_TEXTURE_2D, atlas.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if (!atlas.fbo) glExt.genFramebuffers(1, &atlas.fbo);
+    glExt.bindFramebuffer(GL_FRAMEBUFFER, atlas.fbo);
+    glExt.framebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, atlas.texture, 0);
+    if (glExt.checkFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        glExt.bindFramebuffer(GL_FRAMEBUFFER, 0);
+        std::cerr << "Cloud atlas: framebuffer incomplete, drawing clouds live" << std::endl;
+        atlas.enabled = false;
+        return false;
+    }
+
+    glViewport(0, 0, w, h);
+    gfx->pushProjection();
+    gfx->setProjection(0, (float)w, 0, (float)h);
+    gfx->pushMatrix();
+    gfx->loadIdentity();
+    gfx->setLighting(false);
+
+    // Cells are cleared to their cloud colour at zero alpha so filtered
+    // edges fade out instead of darkening
+    float savedPixelsPerUnit = pixelsPerUnit;
+    pixelsPerUnit = 1.0f;
+    float unitsToPixels = atlas.cellW / CLOUD_BOX_W;
+    glEnable(GL_SCISSOR_TEST);
+    for (int row = 0; row < 2; ++row) {
+        const float* color = row ? cloudNightColor : cloudDayColor;
+        for (int shape = 0; shape < CLOUD_SHAPES; ++shape) {
+            glScissor(shape * atlas.cellW, row * atlas.cellH, atlas.cellW, atlas.cellH);
+            glClearColor(color[0], color[1], color[2], 0.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            gfx->color3f(color[0], color[1], color[2]);
+            drawCloudShape(cloudShapes[shape],
+                shape * atlas.cellW - CLOUD_BOX_LEFT * unitsToPixels,
+                row * atlas.cellH - CLOUD_BOX_BOTTOM * unitsToPixels, unitsToPixels);
+        }
+    }
+    glDisable(GL_SCISSOR_TEST);
+    pixelsPerUnit = savedPixelsPerUnit;
+
+    gfx->popMatrix();
+    gfx->popProjection();
+    glExt.bindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, viewportW, viewportH);
+    if (isNightMode) gfx->setLighting(true);
+
+    atlas.valid = true;
+    return true;
+}
+
+// Visible clouds of [begin, end) into a batch already sized for the whole
+// field, packed from sprites[begin] on; returns how many were kept
+size_t updateCloudSprites(float t, bool night, SpriteInstance* sprites, size_t begin, size_t end) {
+    float row = night ? 1.0f : 0.0f;
+    size_t kept = begin;
+    for (size_t i = begin; i < end; ++i) {
+        const Cloud& cloud = clouds[i];
+        float x, y;
+        cloudPosition(cloud, t, x, y);
+        SpriteInstance& sp = sprites[kept];
+        sp.x = x + CLOUD_BOX_LEFT * cloud.scale;
+        sp.y = y + CLOUD_BOX_BOTTOM * cloud.scale;
+        sp.w = CLOUD_BOX_W * cloud.scale;
+        sp.h = CLOUD_BOX_H * cloud.scale;
+        if (!isVisible(rectBounds(sp.x, sp.y, sp.w, sp.h))) continue;
+        sp.u0 = (float)cloud.shape / CLOUD_SHAPES;
+        sp.u1 = (float)(cloud.shape + 1) / CLOUD_SHAPES;
+        sp.v0 = row * 0.5f;
+        sp.v1 = row * 0.5f + 0.5f;
+        if (night) {
+            float tint[3];
+            moonLightTint(x, y, tint);
+            sp.r = tint[0];
+            sp.g = tint[1];
+            sp.b = tint[2];
+        }
+        else sp.r = sp.g = sp.b = 1.0f;
+        sp.a = cloudLayers[cloud.layer].alpha;
+        ++kept;
+    }
+    return kept - begin;
+}
+
+void updateCloudSprites(float t, bool night, std::vector<SpriteInstance>& sprites) {
+    sprites.resize(clouds.size());
+    sprites.resize(updateCloudSprites(t, night, sprites.data(), 0, clouds.size()));
+}
+
+// The sprite batch is filled by prepareFrame
+void drawClouds(float t) {
+    if (!cloudAtlasUsable() || !buildCloudAtlas()) {
+        for (const Cloud& cloud : clouds) drawCloud(cloud, t);
+        return;
+    }
+    gfx->setLighting(false);
+    gfx->setBlend(true);
+    gfx->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    gfx->drawSprites(cloudAtlas.texture, cloudAtlas.sprites.data(), (int)cloudAtlas.sprites.size());
+    gfx->setBlend(false);
+    if (isNightMode) gfx->setLighting(true);
+}
+
+// ----------------- Profiler -----------------
+// CPU time per draw stage from steady_clock, GPU time from GL timestamp
+// queries read back a few frames later so the pipeline never stalls.
+enum ProfileStage {
+    STAGE_SIMULATION, STAGE_PREPARE, STAGE_STARS, STAGE_CELESTIAL, STAGE_CLOUDS, STAGE_OCEAN,
+    STAGE_SAIL_BOAT, STAGE_SAND, STAGE_VOLLEYBALL, STAGE_PALM_TREES, STAGE_UMBRELLA,
+    STAGE_COUNT
+};
+const char* profileStageNames[STAGE_COUNT] = {
+    "simulation", "prepare", "stars", "celestial", "clouds", "ocean",
+    "sail_boat", "sand", "volleyball", "palm_trees", "umbrella"
+};
+
+const int PROFILE_HISTORY = 240;
+const int PROFILE_QUERY_FRAMES = 4;
+
+struct ProfileRecord {
+    long long frame;
+    float time;
+    double frameMs;
+    double cpuMs[STAGE_COUNT];
+    double gpuMs[STAGE_COUNT];
+    StateStats state;
+};
+
+struct Profiler {
+    bool overlayVisible = false;
+    bool recording = false;
+    std::string csvPath;
+    std::string jsonPath;
+
+    long long frame = 0;
+    std::chrono::steady_clock::time_point frameStart;
+    std::chrono::steady_clock::time_point stageStart[STAGE_COUNT];
+    double cpuMs[STAGE_COUNT] = {};
+    double gpuMs[STAGE_COUNT] = {};
+    double frameMs = 0.0;
+    StateStats state;
+
+    float history[PROFILE_HISTORY] = {};
+    int historyPos = 0;
+
+    GLuint queries[PROFILE_QUERY_FRAMES][STAGE_COUNT][2] = {};
+    long long queryFrame[PROFILE_QUERY_FRAMES] = {};
+    bool queryIssued[PROFILE_QUERY_FRAMES][STAGE_COUNT] = {};
+    bool queriesReady = false;
+
+    std::vector<ProfileRecord> records;
+};
+static Profiler profiler;
+
+void profilerInit() {
+    if (!glExt.timerQuery) return;
+    glExt.genQueries(PROFILE_QUERY_FRAMES * STAGE_COUNT * 2, &profiler.queries[0][0][0]);
+    for (int i = 0; i < PROFILE_QUERY_FRAMES; ++i) profiler.queryFrame[i] = -1;
+    profiler.queriesReady = true;
+}
+
+// Read back any timestamp pairs that have landed for an older frame
+void profilerCollectGpu(int slot) {
+    long long frame = profiler.queryFrame[slot];
+    if (frame < 0) return;
+    for (int s = 0; s < STAGE_COUNT; ++s) {
+        if (!profiler.queryIssued[slot][s]) continue;
+        GLint available = 0;
+        glExt.getQueryObjectiv(profiler.queries[slot][s][1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+        unsigned long long begin = 0, end = 0;
+        glExt.getQueryObjectui64v(profiler.queries[slot][s][0], GL_QUERY_RESULT, &begin);
+        glExt.getQueryObjectui64v(profiler.queries[slot][s][1], GL_QUERY_RESULT, &end);
+        profiler.gpuMs[s] = (end - begin) / 1.0e6;
+        profiler.queryIssued[slot][s] = false;
+        if (profiler.recording && frame < (long long)profiler.records.size()) profiler.records[frame].gpuMs[s] = profiler.gpuMs[s];
+    }
+}
+
+void profilerBeginFrame() {
+    profiler.frameStart = std::chrono::steady_clock::now();
+    gfx->resetStateStats();
+    for (int s = 0; s < STAGE_COUNT; ++s) profiler.cpuMs[s] = 0.0;
+    if (profiler.queriesReady) {
+        int slot = profiler.frame % PROFILE_QUERY_FRAMES;
+        profilerCollectGpu(slot);
+        for (int s = 0; s < STAGE_COUNT; ++s) profiler.queryIssued[slot][s] = false;
+        profiler.queryFrame[slot] = profiler.frame;
+    }
+}
+
+void profilerEndFrame(float t) {
+    auto now = std::chrono::steady_clock::now();
+    profiler.frameMs = std::chrono::duration<double, std::milli>(now - profiler.frameStart).count();
+    profiler.state = gfx->stateStats();
+    profiler.history[profiler.historyPos] = (float)profiler.frameMs;
+    profiler.historyPos = (profiler.historyPos + 1) % PROFILE_HISTORY;
+
+    if (profiler.recording) {
+        ProfileRecord rec;
+        rec.frame = profiler.frame;
+        rec.time = t;
+        rec.frameMs = profiler.frameMs;
+        rec.state = profiler.state;
+        for (int s = 0; s < STAGE_COUNT; ++s) {
+            rec.cpuMs[s] = profiler.cpuMs[s];
+            rec.gpuMs[s] = -1.0;
+        }
+        profiler.records.push_back(rec);
+    }
+    profiler.frame++;
+}
+
+void profilerBeginStage(int stage) {
+    if (profiler.queriesReady) {
+        int slot = profiler.frame % PROFILE_QUERY_FRAMES;
+        glExt.queryCounter(profiler.queries[slot][stage][0], GL_TIMESTAMP);
+    }
+    profiler.stageStart[stage] = std::chrono::steady_clock::now();
+}
+
+void profilerEndStage(int stage) {
+    auto now = std::chrono::steady_clock::now();
+    profiler.cpuMs[stage] += std::chrono::duration<double, std::milli>(now - profiler.stageStart[stage]).count();
+    if (profiler.queriesReady) {
+        int slot = profiler.frame % PROFILE_QUERY_FRAMES;
+        glExt.queryCounter(profiler.queries[slot][stage][1], GL_TIMESTAMP);
+        profiler.queryIssued[slot][stage] = true;
+    }
+}
+
+struct ProfileScope {
+    int stage;
+    explicit ProfileScope(int s) : stage(s) { profilerBeginStage(stage); }
+    ~ProfileScope() { profilerEndStage(stage); }
+};
+
+void drawOverlayText(float x, float y, const char* text) {
+    // Bitmap fonts need GLUT, which headless runs never initialise; the
+    // embedded font of the core backend doesn't
+    if (isHeadless && !textAtlasUsable()) return;
+    drawText(x, y, GLUT_BITMAP_HELVETICA_10, text);
+}
+
+void drawProfilerOverlay() {
+    if (!profiler.overlayVisible) return;
+
+    gfx->pushProjection();
+    gfx->setProjection(0, WIN_W, 0, WIN_H);
+    gfx->pushMatrix();
+    gfx->loadIdentity();
+    gfx->setLighting(false);
+    gfx->setBlend(true);
+    gfx->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    float panelW = 260.0f, graphH = 60.0f;
+    float panelH = graphH + 54.0f + STAGE_COUNT * 14.0f;
+    float panelX = WIN_W - panelW - 10.0f;
+    float panelY = WIN_H - panelH - 10.0f;
+    gfx->color4f(0.0f, 0.0f, 0.0f, 0.6f);
+    myFilledRect(panelX, panelY, panelW, panelH);
+
+    // Rolling frame-time graph, 0..33 ms with a 16.7 ms guide
+    float graphX = panelX + 10.0f, graphY = panelY + panelH - graphH - 10.0f, graphW = panelW - 20.0f;
+    float msScale = graphH / 33.3f;
+    gfx->lineWidth(1.0f);
+    gfx->color4f(1.0f, 1.0f, 1.0f, 0.3f);
+    gfx->begin(GL_LINES);
+    gfx->vertex2f(graphX, graphY + 16.7f * msScale);
+    gfx->vertex2f(graphX + graphW, graphY + 16.7f * msScale);
+    gfx->end();
+    gfx->color3f(0.3f, 1.0f, 0.4f);
+    gfx->begin(GL_LINE_STRIP);
+    for (int i = 0; i < PROFILE_HISTORY; ++i) {
+        float ms = profiler.history[(profiler.historyPos + i) % PROFILE_HISTORY];
+        gfx->vertex2f(graphX + graphW * i / (PROFILE_HISTORY - 1), graphY + std::min(ms, 33.3f) * msScale);
+    }
+    gfx->end();
+
+    char line[96];
+    gfx->color3f(1.0f, 1.0f, 1.0f);
+    snprintf(line, sizeof(line), "frame %.2f ms%s", profiler.frameMs, profiler.queriesReady ? "   (cpu / gpu)" : "   (cpu)");
+    drawOverlayText(graphX, graphY - 14.0f, line);
+
+    // Per-stage breakdown, bar length is CPU time at 40 px per ms
+    for (int s = 0; s < STAGE_COUNT; ++s) {
+        float rowY = graphY - 30.0f - s * 14.0f;
+        gfx->color4f(1.0f, 0.7f, 0.2f, 0.8f);
+        myFilledRect(graphX + 150.0f, rowY, std::min((float)profiler.cpuMs[s] * 40.0f, graphW - 150.0f), 8.0f);
+        gfx->color3f(1.0f, 1.0f, 1.0f);
+        if (profiler.queriesReady) snprintf(line, sizeof(line), "%-10s %.2f / %.2f", profileStageNames[s], profiler.cpuMs[s], profiler.gpuMs[s]);
+        else snprintf(line, sizeof(line), "%-10s %.2f", profileStageNames[s], profiler.cpuMs[s]);
+        drawOverlayText(graphX, rowY, line);
+    }
+    snprintf(line, sizeof(line), "state changes %d, elided %d", profiler.state.applied, profiler.state.elided);
+    drawOverlayText(graphX, graphY - 30.0f - STAGE_COUNT * 14.0f, line);
+
+    gfx->setBlend(false);
+    if (isNightMode) gfx->setLighting(true);
+    gfx->popMatrix();
+    gfx->popProjection();
+}
+
+void writeProfileReports() {
+    const std::vector<ProfileRecord>& recs = profiler.records;
+    if (!profiler.csvPath.empty()) {
+        FILE* f = fopen(profiler.csvPath.c_str(), "w");
+        if (f) {
+            fprintf(f, "frame,time,frame_ms");
+            for (int s = 0; s < STAGE_COUNT; ++s) fprintf(f, ",%s_cpu_ms", profileStageNames[s]);
+            for (int s = 0; s < STAGE_COUNT; ++s) fprintf(f, ",%s_gpu_ms", profileStageNames[s]);
+            fprintf(f, ",state_changes,state_elided\n");
+            for (const ProfileRecord& r : recs) {
+                fprintf(f, "%lld,%.4f,%.4f", r.frame, r.time, r.frameMs);
+                for (int s = 0; s < STAGE_COUNT; ++s) fprintf(f, ",%.4f", r.cpuMs[s]);
+                for (int s = 0; s < STAGE_COUNT; ++s) fprintf(f, ",%.4f", r.gpuMs[s]);
+                fprintf(f, ",%d,%d\n", r.state.applied, r.state.elided);
+            }
+            fclose(f);
+        }
+        else std::cerr << "Profiler: could not write " << profiler.csvPath << std::endl;
+    }
+    if (!profiler.jsonPath.empty()) {
+        FILE* f = fopen(profiler.jsonPath.c_str(), "w");
+        if (f) {
+            fprintf(f, "{\n  \"stages\": [");
+            for (int s = 0; s < STAGE_COUNT; ++s) fprintf(f, "%s\"%s\"", s ? ", " : "", profileStageNames[s]);
+            fprintf(f, "],\n  \"frames\": [\n");
+            for (size_t i = 0; i < recs.size(); ++i) {
+                const ProfileRecord& r = recs[i];
+                fprintf(f, "    {\"frame\": %lld, \"time\": %.4f, \"frame_ms\": %.4f, \"cpu_ms\": [", r.frame, r.time, r.frameMs);
+                for (int s = 0; s < STAGE_COUNT; ++s) fprintf(f, "%s%.4f", s ? ", " : "", r.cpuMs[s]);
+                fprintf(f, "], \"gpu_ms\": [");
+                for (int s = 0; s < STAGE_COUNT; ++s) fprintf(f, "%s%.4f", s ? ", " : "", r.gpuMs[s]);
+                fprintf(f, "], \"state_changes\": %d, \"state_elided\": %d}%s\n", r.state.applied, r.state.elided,
+                    i + 1 < recs.size() ? "," : "");
+            }
+            fprintf(f, "  ]\n}\n");
+            fclose(f);
+        }
+        else std::cerr << "Profiler: could not write " << profiler.jsonPath << std::endl;
+    }
+}
+
+// Average per-stage cost over everything recorded, GPU columns skip frames
+// whose queries never resolved
+void printProfileSummary() {
+    if (profiler.records.empty()) return;
+    printf("%-12s %10s %10s\n", "stage", "cpu ms", "gpu ms");
+    for (int s = 0; s < STAGE_COUNT; ++s) {
+        double cpu = 0.0, gpu = 0.0;
+        int gpuFrames = 0;
+        for (const ProfileRecord& r : profiler.records) {
+            cpu += r.cpuMs[s];
+            if (r.gpuMs[s] >= 0.0) { gpu += r.gpuMs[s]; gpuFrames++; }
+        }
+        cpu /= profiler.records.size();
+        if (gpuFrames) printf("%-12s %10.4f %10.4f\n", profileStageNames[s], cpu, gpu / gpuFrames);
+        else printf("%-12s %10.4f %10s\n", profileStageNames[s], cpu, "-");
+    }
+    double applied = 0.0, elided = 0.0;
+    for (const ProfileRecord& r : profiler.records) {
+        applied += r.state.applied;
+        elided += r.state.elided;
+    }
+    printf("state changes per frame: %.1f applied, %.1f elided\n",
+        applied / profiler.records.size(), elided / profiler.records.size());
+}
+
+// ----------------- Draw Queue -----------------
+// The scene's top-level draws are queued with the depth layer they paint
+// into and the lighting/blend state they start in, then submitted sorted by
+// layer and, within a layer, by that state so draws needing the same state
+// run back to back. Only draws that never overlap share a layer, so the
+// reorder cannot change the image; the sort is stable for equal keys.
+enum DrawLayer {
+    LAYER_SKY, LAYER_CELESTIAL, LAYER_CLOUDS, LAYER_SEA, LAYER_BOAT,
+    LAYER_BEACH, LAYER_PROPS, LAYER_FOREGROUND
+};
+
+struct DrawItem {
+    int layer;
+    int stateKey;
+    int stage;
+    std::function<void()> draw;
+};
+
+struct DrawQueue {
+    bool sorted = true;
+    std::vector<DrawItem> items;
+};
+static DrawQueue drawQueue;
+
+void submitDraw(int layer, int stage, bool lit, bool blended, std::function<void()> draw) {
+    // Lighting only exists at night, so by day it doesn't split the batches
+    int stateKey = ((lit && isNightMode) ? 1 : 0) | (blended ? 2 : 0);
+    drawQueue.items.push_back({ layer, stateKey, stage, std::move(draw) });
+}
+
+void flushDrawQueue() {
+    std::vector<DrawItem>& items = drawQueue.items;
+    if (drawQueue.sorted) {
+        std::stable_sort(items.begin(), items.end(), [](const DrawItem& a, const DrawItem& b) {
+            return a.layer != b.layer ? a.layer < b.layer : a.stateKey < b.stateKey;
+        });
+    }
+    for (DrawItem& item : items) {
+        ProfileScope scope(item.stage);
+        item.draw();
+    }
+    items.clear();
+}
+
+// ----------------- Worker Pool -----------------
+// Fork-join pool for the per-frame geometry builders. Every job writes only
+// its own layer's buffers (or its own slice of them), and the GL thread
+// works through the list too, then waits for the rest before any draw is
+// submitted, so GL calls never leave the GL thread.
+struct WorkerPool {
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable workDone;
+    const std::vector<std::function<void()>>* jobs = nullptr;
+    size_t nextJob = 0;
+    size_t jobsLeft = 0;
+    bool stopping = false;
+};
+static WorkerPool workerPool;
+static int workerCount = -1;   // -1 picks one from the core count
+
+// Star and cloud slices are sized so a job outweighs the hand-off
+const size_t STAR_JOB_SIZE = 16384;
+const size_t CLOUD_JOB_SIZE = 512;
+static std::vector<std::function<void()>> frameJobs;
+static std::vector<size_t> cloudSliceCounts;
+
+// Runs claimed jobs until the list is empty; called with the lock held
+void drainJobs(std::unique_lock<std::mutex>& lock) {
+    WorkerPool& pool = workerPool;
+    while (pool.jobs && pool.nextJob < pool.jobs->size()) {
+        const std::function<void()>& job = (*pool.jobs)[pool.nextJob++];
+        lock.unlock();
+        job();
+        lock.lock();
+        if (--pool.jobsLeft == 0) pool.workDone.notify_all();
+    }
+}
+
+void workerLoop() {
+    WorkerPool& pool = workerPool;
+    std::unique_lock<std::mutex> lock(pool.mutex);
+    for (;;) {
+        pool.workReady.wait(lock, [&pool]() {
+            return pool.stopping || (pool.jobs && pool.nextJob < pool.jobs->size());
+        });
+        if (pool.stopping) return;
+        drainJobs(lock);
+    }
+}
+
+void stopWorkers() {
+    WorkerPool& pool = workerPool;
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.stopping = true;
+    }
+    pool.workReady.notify_all();
+    for (std::thread& thread : pool.threads) thread.join();
+    pool.threads.clear();
+}
+
+void startWorkers(int count) {
+    if (count < 0) {
+        // The GL thread is the other worker; past four the jobs run out
+        int cores = (int)std::thread::hardware_concurrency();
+        count = std::min(std::max(cores - 1, 0), 3);
+    }
+    for (int i = 0; i < count; ++i) workerPool.threads.emplace_back(workerLoop);
+    if (count > 0) atexit(stopWorkers);
+}
+
+void runJobs(const std::vector<std::function<void()>>& jobs) {
+    WorkerPool& pool = workerPool;
+    if (pool.threads.empty() || jobs.size() < 2) {
+        for (const std::function<void()>& job : jobs) job();
+        return;
+    }
+    std::unique_lock<std::mutex> lock(pool.mutex);
+    pool.jobs = &jobs;
+    pool.nextJob = 0;
+    pool.jobsLeft = jobs.size();
+    pool.workReady.notify_all();
+    drainJobs(lock);
+    pool.workDone.wait(lock, [&pool]() { return pool.jobsLeft == 0; });
+    pool.jobs = nullptr;
+}
+
+// Everything each layer recomputes per frame without touching GL: star
+// twinkle, the ocean heightfield and mesh, the posed prop batches and the
+// cloud sprites. Layers outside the cull window are skipped.
+void prepareFrame(float t, bool night) {
+    frameJobs.clear();
+    if (night && isVisible(stars.bounds)) {
+        for (size_t begin = 0; begin < stars.phaseSin.size(); begin += STAR_JOB_SIZE) {
+            size_t end = std::min(begin + STAR_JOB_SIZE, stars.phaseSin.size());
+            frameJobs.push_back([t, begin, end]() { updateStarTwinkle(t, begin, end); });
+        }
+    }
+    if (isVisible(oceanBounds())) frameJobs.push_back([t, night]() { prepareOcean(t, night); });
+    frameJobs.push_back([t]() { prepareProps(t); });
+    bool cloudSprites = cloudAtlasUsable();
+    if (cloudSprites) {
+        cloudAtlas.sprites.resize(clouds.size());
+        SpriteInstance* sprites = cloudAtlas.sprites.data();
+        size_t slices = (clouds.size() + CLOUD_JOB_SIZE - 1) / CLOUD_JOB_SIZE;
+        cloudSliceCounts.assign(slices, 0);
+        for (size_t slice = 0; slice < slices; ++slice) {
+            size_t begin = slice * CLOUD_JOB_SIZE;
+            size_t end = std::min(begin + CLOUD_JOB_SIZE, clouds.size());
+            size_t* kept = &cloudSliceCounts[slice];
+            frameJobs.push_back([t, night, sprites, begin, end, kept]() { *kept = updateCloudSprites(t, night, sprites, begin, end); });
+        }
+    }
+    runJobs(frameJobs);
+
+    // Close the gaps the culled clouds left at the end of each slice
+    if (cloudSprites) {
+        std::vector<SpriteInstance>& sprites = cloudAtlas.sprites;
+        size_t count = 0;
+        for (size_t slice = 0; slice < cloudSliceCounts.size(); ++slice) {
+            size_t begin = slice * CLOUD_JOB_SIZE;
+            if (begin != count) std::copy(sprites.begin() + begin, sprites.begin() + begin + cloudSliceCounts[slice], sprites.begin() + count);
+            count += cloudSliceCounts[slice];
+        }
+        sprites.resize(count);
+    }
+}
+
+// ----------------- Simulation -----------------
+void stepSimulation(float t) {
+    stepShootingStar(t);
+    stepVolleyballArms(SAND_TOP_Y, t);
+}
+
+// Run as many fixed ticks as the clock has moved since the last frame
+void advanceSimulation(float t) {
+    if (simLastFrameTime < 0.0f || t < simLastFrameTime) {
+        simTime = t;
+        simAccumulator = 0.0f;
+        simLastFrameTime = t;
+        return;
+    }
+    float frameDt = t - simLastFrameTime;
+    simLastFrameTime = t;
+    if (frameDt > SIM_MAX_CATCHUP) {
+        simTime += frameDt - SIM_MAX_CATCHUP;
+        frameDt = SIM_MAX_CATCHUP;
+    }
+    simAccumulator += frameDt;
+    while (simAccumulator >= SIM_DT) {
+        simTime += SIM_DT;
+        stepSimulation(simTime);
+        simAccumulator -= SIM_DT;
+    }
+}
+
+// ----------------- Frame Scheduler -----------------
+// Replaces redrawing from the idle callback. Continuous mode paces frames to
+// a target rate with a GLUT timer, sleeping until the next deadline measured
+// after the (possibly vsync-blocked) swap; OnDemand mode only redraws after
+// input marks the scene dirty. Nothing is scheduled while the window is hidden.
+enum class PacingMode { Continuous, OnDemand };
+struct FrameScheduler {
+    PacingMode mode = PacingMode::Continuous;
+    float targetFps = 60.0f;
+    bool vsync = true;
+    bool visible = true;
+    bool dirty = true;
+    bool timerPending = false;
+    double nextDeadline = 0.0;
+};
+static FrameScheduler scheduler;
+const float CREDITS_MAX_FPS = 30.0f;
+
+void onFrameTimer(int) {
+    scheduler.timerPending = false;
+    glutPostRedisplay();
+}
+
+void scheduleNextFrame() {
+    if (isHeadless || !scheduler.visible || scheduler.timerPending) return;
+    if (scheduler.mode == PacingMode::OnDemand && !scheduler.dirty) return;
+
+    // The credits screen only animates the prompt's alpha
+    float targetFps = scheduler.targetFps;
+    if (showCredits && (targetFps <= 0.0f || targetFps > CREDITS_MAX_FPS)) targetFps = CREDITS_MAX_FPS;
+
+    double now = realSecs();
+    unsigned int waitMs = 0;
+    if (targetFps > 0.0f) {
+        double period = 1.0 / targetFps;
+        scheduler.nextDeadline += period;
+        // More than a frame behind (hitch, or the window was hidden): resync
+        if (scheduler.nextDeadline < now - period) scheduler.nextDeadline = now;
+        double wait = scheduler.nextDeadline - now;
+        if (wait > 0.0) waitMs = (unsigned int)(wait * 1000.0);
+    }
+    scheduler.timerPending = true;
+    glutTimerFunc(waitMs, onFrameTimer, 0);
+}
+
+void markDirty() {
+    scheduler.dirty = true;
+    if (!isHeadless && scheduler.mode == PacingMode::OnDemand) glutPostRedisplay();
+}
 
-    drawVolleyball(ballX, ballY, 12);
+void applySwapInterval() {
+    if (glExt.swapInterval) glExt.swapInterval(scheduler.vsync ? 1 : 0);
+}
+
+void visibility(int state) {
+    scheduler.visible = (state == GLUT_VISIBLE);
+    if (scheduler.visible) {
+        scheduler.nextDeadline = realSecs();
+        markDirty();
+        scheduleNextFrame();
+    }
 }
 
 // ----------------- CALLBACKS -----------------
@@ -754,18 +3790,20 @@ void drawVolleyballGame(float baseY, float t) {
 void mouseMotion(int x, int y) {
     if (!showCredits) {
         umbX_global = (float)x * globalZoom;
+        markDirty();
     }
 }
 
 void reshape(int w, int h) {
+    markDirty();
+    viewportW = w;
+    viewportH = h;
     glViewport(0, 0, w, h);
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    gluOrtho2D(0, WIN_W, 0, WIN_H);
-    glMatrixMode(GL_MODELVIEW);
+    gfx->setProjection(0, WIN_W, 0, WIN_H);
 }
 
 void keyboard(unsigned char key, int x, int y) {
+    markDirty();
     if (showCredits) {
         showCredits = false;
         glutPostRedisplay();
@@ -776,12 +3814,11 @@ void keyboard(unsigned char key, int x, int y) {
         case 'n': case 'N':
             isNightMode = !isNightMode;
             if (isNightMode) {
-                glEnable(GL_COLOR_MATERIAL);
-                glColorMaterial(GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
+                gfx->enableColorMaterial();
                 sStarNextSpawnTime = secs() + 2.0f;
             }
             else {
-                glDisable(GL_LIGHTING);
+                gfx->setLighting(false);
             }
             break;
         case '+':
@@ -791,6 +3828,9 @@ void keyboard(unsigned char key, int x, int y) {
         case '-':
             globalZoom += 0.1f;
             break;
+        case 'p': case 'P':
+            profiler.overlayVisible = !profiler.overlayVisible;
+            break;
         case 27:
             exit(0);
             break;
@@ -800,19 +3840,31 @@ void keyboard(unsigned char key, int x, int y) {
 
 // ----------------- Main Display -----------------
 void display() {
+    tickClock();
+    scheduler.dirty = false;
+    gfx->beginFrame();
+
     if (showCredits) {
+        pixelsPerUnit = std::max((float)viewportW / WIN_W, (float)viewportH / WIN_H);
         drawCredits();
+        scheduleNextFrame();
         return;
     }
 
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
     float cx = WIN_W / 2.0f;
     float cy = WIN_H / 2.0f;
-    gluOrtho2D(cx - (cx * globalZoom), cx + (cx * globalZoom),
-        cy - (cy * globalZoom), cy + (cy * globalZoom));
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+    float viewLeft = cx - (cx * globalZoom), viewRight = cx + (cx * globalZoom);
+    float viewBottom = cy - (cy * globalZoom), viewTop = cy + (cy * globalZoom);
+    gfx->setProjection(viewLeft, viewRight, viewBottom, viewTop);
+    gfx->loadIdentity();
+    pixelsPerUnit = std::max(viewportW / (viewRight - viewLeft), viewportH / (viewTop - viewBottom));
+    setCullWindow(viewLeft, viewRight, viewBottom, viewTop, 1.0f / pixelsPerUnit);
+
+    bool useBackgroundCache = backgroundCacheUsable();
+    if (useBackgroundCache) {
+        updateBackgroundCache(viewLeft, viewRight, viewBottom, viewTop);
+        useBackgroundCache = backgroundCacheUsable();
+    }
 
     if (isNightMode) glClearColor(0.05f, 0.05f, 0.2f, 1.0f);
     else glClearColor(0.6f, 0.92f, 1.0f, 1.0f);
@@ -820,57 +3872,470 @@ void display() {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     float t = secs();
+    profilerBeginFrame();
+
+    {
+        ProfileScope scope(STAGE_SIMULATION);
+        advanceSimulation(t);
+    }
+    {
+        ProfileScope scope(STAGE_PREPARE);
+        prepareFrame(t, isNightMode);
+    }
+    // The volleyball court and the palm trees are far enough apart to share
+    // a layer; everything else overlaps its neighbours. Culled elements are
+    // left out, except that the moon still has to light the scene.
+    submitDraw(LAYER_SKY, STAGE_STARS, false, true, [t]() {
+        if (isVisible(stars.bounds)) drawStars();
+        drawShootingStar();
+    });
+    if (!isVisible(celestialBounds(CELESTIAL_X, CELESTIAL_Y, CELESTIAL_R))) {
+        if (isNightMode) submitDraw(LAYER_CELESTIAL, STAGE_CELESTIAL, false, false, []() { enableMoonLight(CELESTIAL_X, CELESTIAL_Y); });
+    }
+    else submitDraw(LAYER_CELESTIAL, STAGE_CELESTIAL, false, true, [t, useBackgroundCache]() {
+        if (useBackgroundCache) {
+            drawCelestialHalo(CELESTIAL_X, CELESTIAL_Y, CELESTIAL_R, t);
+            compositeBackground(CELESTIAL_X - CELESTIAL_R, CELESTIAL_Y - CELESTIAL_R, CELESTIAL_R * 2.0f, CELESTIAL_R * 2.0f);
+            if (isNightMode) enableMoonLight(CELESTIAL_X, CELESTIAL_Y);
+        }
+        else drawCelestialBody(CELESTIAL_X, CELESTIAL_Y, CELESTIAL_R, t);
+    });
+    submitDraw(LAYER_CLOUDS, STAGE_CLOUDS, false, true, [t]() { drawClouds(t); });
+    if (isVisible(oceanBounds())) submitDraw(LAYER_SEA, STAGE_OCEAN, false, false, []() { drawOcean(); });
+    if (!propBatches.sailBoat.runs.empty()) {
+        submitDraw(LAYER_BOAT, STAGE_SAIL_BOAT, true, false, []() { drawSceneBatch(propBatches.sailBoat); });
+    }
+    if (isVisible(rectBounds(0.0f, 0.0f, WIN_W, SAND_TOP_Y))) {
+        submitDraw(LAYER_BEACH, STAGE_SAND, true, false, [useBackgroundCache]() {
+            if (useBackgroundCache) compositeBackground(0.0f, 0.0f, WIN_W, SAND_TOP_Y);
+            else drawSand(SAND_TOP_Y);
+        });
+    }
+    if (!propBatches.volleyball.runs.empty()) {
+        submitDraw(LAYER_PROPS, STAGE_VOLLEYBALL, true, false, []() { drawSceneBatch(propBatches.volleyball); });
+    }
+    if (!propBatches.palmTrees.runs.empty()) {
+        submitDraw(LAYER_PROPS, STAGE_PALM_TREES, true, false, []() { drawSceneBatch(propBatches.palmTrees); });
+    }
+    if (!propBatches.umbrella.runs.empty()) {
+        submitDraw(LAYER_FOREGROUND, STAGE_UMBRELLA, true, false, []() { drawSceneBatch(propBatches.umbrella); });
+    }
+    flushDrawQueue();
 
-    drawStars();
-    drawShootingStar(t);
+    profilerEndFrame(t);
+    drawProfilerOverlay();
 
-    drawCelestialBody(180.0f, 650.0f, 50.0f, t);
+    presentFrame();
+    scheduleNextFrame();
+}
 
-    drawCloud(200.0f, 600.0f, 1.0f, t);
-    drawCloud(500.0f, 650.0f, 0.8f, t);
-    drawCloud(850.0f, 620.0f, 1.2f, t);
-    drawOceanBase(0.0f, WIN_W, WIN_H * 0.5f, 0.0f, t);
+void init() {
+    loadGLExtensions();
+    if (rendererBackend == RendererBackend::Core) gfx = &coreRenderer;
+    if (!gfx->init()) {
+        std::cerr << "Renderer: could not initialise the selected backend" << std::endl;
+        exit(1);
+    }
+    gfx->setProjection(0, WIN_W, 0, WIN_H);
+    gfx->loadIdentity();
 
-    drawSailBoat(0.0f, WIN_H * 0.5f + 30.0f, t);
+    profilerInit();
+    startWorkers(workerCount);
 
-    drawSand(WIN_H * 0.35f);
-    drawVolleyballGame(WIN_H * 0.35f, t);
+    initPalmTreeGeometry();
+    initSandGrains(SAND_TOP_Y);
+    initStars();
+    initCloudField(extraCloudCount);
+}
 
-    drawPalmTree(800.0f, WIN_H * 0.35f, t, false);
-    drawPalmTree(650.0f, WIN_H * 0.35f, t, true);
+// ----------------- Headless Mode -----------------
+struct HeadlessOptions {
+    int frames = 300;
+    int width = WIN_W;
+    int height = WIN_H;
+    float fps = 60.0f;
+    bool night = false;
+    float zoom = 1.0f;
+    std::string dumpPrefix;
+};
+
+// --clock real|fixed|scripted, --step SECONDS, --times T0,T1,...
+bool parseClockArgs(int argc, char** argv) {
+    bool specified = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--clock" && hasValue) {
+            std::string mode = argv[++i];
+            if (mode == "fixed") sceneClock.mode = ClockMode::FixedStep;
+            else if (mode == "scripted") sceneClock.mode = ClockMode::Scripted;
+            else sceneClock.mode = ClockMode::RealTime;
+            specified = true;
+        }
+        else if (arg == "--step" && hasValue) {
+            float step = (float)atof(argv[++i]);
+            if (step > 0.0f) sceneClock.fixedStep = step;
+        }
+        else if (arg == "--times" && hasValue) {
+            std::string list = argv[++i];
+            size_t start = 0;
+            while (start < list.size()) {
+                size_t end = list.find(',', start);
+                if (end == std::string::npos) end = list.size();
+                sceneClock.script.push_back((float)atof(list.substr(start, end - start).c_str()));
+                start = end + 1;
+            }
+        }
+    }
+    if (sceneClock.mode == ClockMode::Scripted && sceneClock.script.empty()) sceneClock.script.push_back(0.0f);
+    return specified;
+}
 
-    drawUmbrella(umbX_global, WIN_H * 0.35f, 50.0f);
+// --profile-csv PATH, --profile-json PATH, --overlay
+void parseProfilerArgs(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--profile-csv" && hasValue) profiler.csvPath = argv[++i];
+        else if (arg == "--profile-json" && hasValue) profiler.jsonPath = argv[++i];
+        else if (arg == "--overlay") profiler.overlayVisible = true;
+    }
+    profiler.recording = !profiler.csvPath.empty() || !profiler.jsonPath.empty();
+    if (profiler.recording) atexit(writeProfileReports);
+}
 
-    glutSwapBuffers();
+bool parseHeadlessArgs(int argc, char** argv, HeadlessOptions& opts) {
+    bool headless = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--headless") headless = true;
+        else if (arg == "--frames" && hasValue) opts.frames = atoi(argv[++i]);
+        else if (arg == "--size" && hasValue) sscanf(argv[++i], "%dx%d", &opts.width, &opts.height);
+        else if (arg == "--fps" && hasValue) opts.fps = (float)atof(argv[++i]);
+        else if (arg == "--zoom" && hasValue) opts.zoom = (float)atof(argv[++i]);
+        else if (arg == "--dump" && hasValue) opts.dumpPrefix = argv[++i];
+        else if (arg == "--night") opts.night = true;
+    }
+    if (opts.frames < 1) opts.frames = 1;
+    if (opts.width < 1) opts.width = WIN_W;
+    if (opts.height < 1) opts.height = WIN_H;
+    if (opts.fps <= 0.0f) opts.fps = 60.0f;
+    return headless;
 }
 
-void init() {
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    gluOrtho2D(0, WIN_W, 0, WIN_H);
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+bool writeFramePPM(const std::string& path, int w, int h) {
+    std::vector<unsigned char> pixels(w * h * 3);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, w, h, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    fprintf(f, "P6\n%d %d\n255\n", w, h);
+    for (int y = h - 1; y >= 0; --y) fwrite(&pixels[y * w * 3], 1, w * 3, f);
+    fclose(f);
+    return true;
+}
+
+#ifndef _WIN32
+bool createHeadlessContext(int w, int h) {
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    EGLDisplay dpy = getPlatformDisplay ? getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL)
+                                        : eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (dpy == EGL_NO_DISPLAY || !eglInitialize(dpy, NULL, NULL)) return false;
+
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+        EGL_NONE };
+    EGLConfig config;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(dpy, configAttribs, &config, 1, &numConfigs) || numConfigs < 1) return false;
+
+    const EGLint pbufferAttribs[] = { EGL_WIDTH, w, EGL_HEIGHT, h, EGL_NONE };
+    EGLSurface surface = eglCreatePbufferSurface(dpy, config, pbufferAttribs);
+    if (surface == EGL_NO_SURFACE) return false;
+
+    eglBindAPI(EGL_OPENGL_API);
+    const EGLint coreAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3, EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE };
+    bool core = rendererBackend == RendererBackend::Core;
+    EGLContext ctx = eglCreateContext(dpy, config, EGL_NO_CONTEXT, core ? coreAttribs : NULL);
+    if (ctx == EGL_NO_CONTEXT) return false;
+    return eglMakeCurrent(dpy, surface, surface, ctx) == EGL_TRUE;
+}
+#else
+bool createHeadlessContext(int w, int h) {
+    return false;
+}
+#endif
+
+int runHeadless(const HeadlessOptions& opts, bool clockSpecified) {
+    if (!createHeadlessContext(opts.width, opts.height)) {
+        std::cerr << "Headless mode: could not create an offscreen GL context" << std::endl;
+        return 1;
+    }
+    isHeadless = true;
+    profiler.recording = true;
+    if (!clockSpecified) {
+        sceneClock.mode = ClockMode::FixedStep;
+        sceneClock.fixedStep = 1.0f / opts.fps;
+    }
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << " (" << glGetString(GL_VERSION) << ")" << std::endl;
+
+    init();
+    reshape(opts.width, opts.height);
+    showCredits = false;
+    glClearColor(0.6f, 0.92f, 1.0f, 1.0f);
+    if (opts.night) keyboard('n', 0, 0);
+    globalZoom = opts.zoom;
+
+    std::vector<double> frameMs;
+    frameMs.reserve(opts.frames);
+    for (int i = 0; i < opts.frames; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        display();
+        auto end = std::chrono::steady_clock::now();
+        frameMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+
+        if (!opts.dumpPrefix.empty()) {
+            char name[32];
+            snprintf(name, sizeof(name), "%04d.ppm", i);
+            if (!writeFramePPM(opts.dumpPrefix + name, opts.width, opts.height)) {
+                std::cerr << "Headless mode: could not write " << opts.dumpPrefix + name << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::vector<double> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (double ms : frameMs) total += ms;
+    double avg = total / frameMs.size();
+    printf("Frames: %d at %dx%d\n", opts.frames, opts.width, opts.height);
+    printf("Frame ms: avg %.3f  min %.3f  p50 %.3f  p95 %.3f  max %.3f  (%.1f fps)\n",
+        avg, sorted.front(), sorted[sorted.size() / 2], sorted[(sorted.size() * 95) / 100],
+        sorted.back(), 1000.0 / avg);
+
+    if (profiler.queriesReady) {
+        for (int slot = 0; slot < PROFILE_QUERY_FRAMES; ++slot) profilerCollectGpu(slot);
+    }
+    printProfileSummary();
+    return 0;
+}
+
+// ----------------- Benchmarks -----------------
+// CPU cost of the GL-free geometry builders and animation math. No GL
+// context is created, so the numbers carry no driver noise; submission
+// cost is what the headless profiler measures.
+static volatile float benchSink = 0.0f;
+
+template <typename F>
+void runBenchmark(const std::string& name, const std::string& filter, F&& body) {
+    if (!filter.empty() && name.find(filter) == std::string::npos) return;
+    typedef std::chrono::steady_clock Clock;
+
+    // Double the batch until it runs for ~20 ms, then keep the best of 5 batches
+    long long iters = 1;
+    while (iters < (1LL << 30)) {
+        auto start = Clock::now();
+        for (long long i = 0; i < iters; ++i) body(i);
+        if (std::chrono::duration<double, std::milli>(Clock::now() - start).count() >= 20.0) break;
+        iters *= 2;
+    }
+    double best = 1e30;
+    for (int r = 0; r < 5; ++r) {
+        auto start = Clock::now();
+        for (long long i = 0; i < iters; ++i) body(i);
+        best = std::min(best, std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iters);
+    }
+    printf("%-32s %12lld %14.1f\n", name.c_str(), iters, best);
+}
+
+int runBenchmarks(const std::string& filter) {
+    printf("%-32s %12s %14s\n", "benchmark", "iterations", "ns/op");
+    std::vector<float> scratch;
+
+    const int segmentCounts[] = { 24, 32, 36, 45, 48, 50, 64 };
+    for (int n : segmentCounts) {
+        runBenchmark("circle/tessellate/" + std::to_string(n), filter, [&](long long) {
+            tessellateUnitCircle(n, scratch);
+            benchSink = scratch[2];
+        });
+    }
+
+    runBenchmark("circle/select_segments", filter, [&](long long i) {
+        benchSink = (float)circleSegments(1.0f + (i & 511), 48);
+    });
+
+    runBenchmark("palm/trunk_and_fronds_build", filter, [&](long long) {
+        initPalmTreeGeometry();
+        benchSink = treeTrunkVertices[0];
+    });
+    FrondMesh mesh;
+    runBenchmark("palm/frond_build", filter, [&](long long) {
+        initFrondMesh(mesh, 18.0f, 250.0f, 150.0f, 6.0f);
+        benchSink = mesh.restVertices[0];
+    });
+    runBenchmark("palm/frond_sway", filter, [&](long long i) {
+        updateFrondMesh(mesh, i * SIM_DT);
+        benchSink = mesh.vertices[1];
+    });
+
+    const int oceanColumns[] = { 48, 96, 256 };
+    for (int cols : oceanColumns) {
+        OceanSettings settings;
+        settings.columns = cols;
+        OceanSurface surface;
+        buildOceanBasis(surface, settings, WIN_H * 0.5f, WIN_H * 0.35f);
+        runBenchmark("ocean/heightfield/" + std::to_string(cols), filter, [&](long long i) {
+            updateOceanHeights(surface, i * SIM_DT);
+            benchSink = surface.heights[1];
+        });
+        const float color[3] = { 0.02f, 0.62f, 0.78f };
+        const float crest[4] = { 1.0f, 1.0f, 1.0f, 0.35f };
+        runBenchmark("ocean/mesh/" + std::to_string(cols), filter, [&](long long) {
+            buildOceanMesh(surface, color, crest);
+            benchSink = surface.stripVertices[1];
+        });
+    }
 
-    glEnable(GL_LIGHT0);
-    glEnable(GL_NORMALIZE);
+    const int cloudCounts[] = { 0, 300 };
+    std::vector<SpriteInstance> cloudSprites;
+    for (int extra : cloudCounts) {
+        initCloudField(extra);
+        runBenchmark("clouds/sprites/" + std::to_string(clouds.size()), filter, [&](long long i) {
+            updateCloudSprites(i * SIM_DT, (i & 1) != 0, cloudSprites);
+            benchSink = (float)cloudSprites.size();
+        });
+    }
 
     initPalmTreeGeometry();
-    initStars();
+    runBenchmark("props/scene_graph", filter, [&](long long i) {
+        prepareProps(i * SIM_DT);
+        benchSink = propBatches.volleyball.positions[0];
+    });
+
+    runBenchmark("volleyball/seam", filter, [&](long long) {
+        buildVolleyballSeam(12.0f, scratch);
+        benchSink = scratch[1];
+    });
+    runBenchmark("volleyball/arm_angles", filter, [&](long long i) {
+        stepVolleyballArms(WIN_H * 0.35f, i * SIM_DT);
+        benchSink = prevGirlR;
+    });
+
+    runBenchmark("sand/bake", filter, [&](long long) {
+        initSandGrains(WIN_H * 0.35f);
+        benchSink = sandGrainVertices[0];
+    });
+
+    const int starCounts[] = { 200, 100000 };
+    for (int count : starCounts) {
+        initStars(count);
+        runBenchmark("stars/twinkle/" + std::to_string(count), filter, [&](long long i) {
+            updateStarTwinkle(i * SIM_DT);
+            benchSink = stars.colors[3];
+        });
+    }
+    return 0;
+}
+
+// --target-fps N (0 = unlimited), --pacing continuous|ondemand, --no-vsync
+void parseSchedulerArgs(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--target-fps" && hasValue) scheduler.targetFps = (float)atof(argv[++i]);
+        else if (arg == "--pacing" && hasValue) {
+            std::string mode = argv[++i];
+            scheduler.mode = (mode == "ondemand") ? PacingMode::OnDemand : PacingMode::Continuous;
+        }
+        else if (arg == "--no-vsync") scheduler.vsync = false;
+    }
+}
+
+// --renderer legacy|core, --no-bg-cache, --fixed-tessellation, --chord-error PIXELS,
+// --ocean-columns N, --ocean-rows N, --ocean-octaves N, --no-ocean-crests,
+// --clouds N, --no-cloud-atlas, --no-text-atlas, --no-credits-cache,
+// --no-state-cache, --no-draw-sort, --threads N, --no-cull
+void parseRenderArgs(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--renderer" && i + 1 < argc) {
+            std::string backend = argv[++i];
+            rendererBackend = (backend == "core") ? RendererBackend::Core : RendererBackend::Legacy;
+        }
+        else if (arg == "--no-bg-cache") backgroundCache.enabled = false;
+        else if (arg == "--fixed-tessellation") adaptiveTessellation = false;
+        else if (arg == "--chord-error" && i + 1 < argc) {
+            float err = (float)atof(argv[++i]);
+            if (err > 0.0f) maxChordErrorPx = err;
+        }
+        else if (arg == "--ocean-columns" && i + 1 < argc) oceanSettings.columns = std::max(1, atoi(argv[++i]));
+        else if (arg == "--ocean-rows" && i + 1 < argc) oceanSettings.rows = std::max(1, atoi(argv[++i]));
+        else if (arg == "--ocean-octaves" && i + 1 < argc) oceanSettings.octaves = std::min(std::max(1, atoi(argv[++i])), OCEAN_MAX_OCTAVES);
+        else if (arg == "--no-ocean-crests") oceanSettings.crestLines = false;
+        else if (arg == "--clouds" && i + 1 < argc) extraCloudCount = std::max(0, atoi(argv[++i]));
+        else if (arg == "--no-cloud-atlas") cloudAtlas.enabled = false;
+        else if (arg == "--no-text-atlas") textCache.enabled = false;
+        else if (arg == "--no-credits-cache") creditsCache.enabled = false;
+        else if (arg == "--no-state-cache") elideRedundantState = false;
+        else if (arg == "--no-draw-sort") drawQueue.sorted = false;
+        else if (arg == "--threads" && i + 1 < argc) workerCount = std::max(0, atoi(argv[++i]));
+        else if (arg == "--no-cull") viewCuller.enabled = false;
+    }
+}
+
+// --bench [--bench-filter SUBSTRING]
+bool parseBenchArgs(int argc, char** argv, std::string& filter) {
+    bool bench = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--bench") bench = true;
+        else if (arg == "--bench-filter" && i + 1 < argc) filter = argv[++i];
+    }
+    return bench;
 }
 
 int main(int argc, char** argv) {
+    std::string benchFilter;
+    if (parseBenchArgs(argc, argv, benchFilter)) return runBenchmarks(benchFilter);
+
+    bool clockSpecified = parseClockArgs(argc, argv);
+    parseProfilerArgs(argc, argv);
+    parseRenderArgs(argc, argv);
+    HeadlessOptions headlessOpts;
+    if (parseHeadlessArgs(argc, argv, headlessOpts)) return runHeadless(headlessOpts, clockSpecified);
+
     glutInit(&argc, argv);
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
     glutInitWindowSize(WIN_W, WIN_H);
+    if (rendererBackend == RendererBackend::Core) {
+#ifdef FREEGLUT
+        glutInitContextVersion(3, 3);
+        glutInitContextProfile(GLUT_CORE_PROFILE);
+#else
+        std::cerr << "Renderer: this GLUT cannot request a core context, using legacy" << std::endl;
+        rendererBackend = RendererBackend::Legacy;
+#endif
+    }
     glutCreateWindow("FINAL PROJECT");
 
     init();
+    parseSchedulerArgs(argc, argv);
+    applySwapInterval();
 
     glutDisplayFunc(display);
-    glutIdleFunc(display);
     glutReshapeFunc(reshape);
     glutKeyboardFunc(keyboard);
     glutMotionFunc(mouseMotion);
+    glutVisibilityFunc(visibility);
 
     glutMainLoop();
     return 0;
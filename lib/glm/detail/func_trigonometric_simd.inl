@@ -0,0 +1,69 @@
+/// @ref core
+/// @file glm/detail/func_trigonometric_simd.inl
+
+#include "../simd/trigonometric.h"
+
+#if (GLM_ARCH & GLM_ARCH_SSE2_BIT) || (GLM_ARCH & GLM_ARCH_NEON_BIT)
+
+namespace glm{
+namespace detail
+{
+	// Arguments the kernels don't cover (see simd/trigonometric.h) take the
+	// libm path for the whole vector
+
+	template<qualifier Q>
+	struct compute_sin<4, float, Q, true>
+	{
+		GLM_FUNC_QUALIFIER static vec<4, float, Q> call(vec<4, float, Q> const& v)
+		{
+			if(!glm_vec4_trig_in_range(v.data))
+				return compute_sin<4, float, Q, false>::call(v);
+			vec<4, float, Q> Result;
+			Result.data = glm_vec4_sin(v.data);
+			return Result;
+		}
+	};
+
+	template<qualifier Q>
+	struct compute_cos<4, float, Q, true>
+	{
+		GLM_FUNC_QUALIFIER static vec<4, float, Q> call(vec<4, float, Q> const& v)
+		{
+			if(!glm_vec4_trig_in_range(v.data))
+				return compute_cos<4, float, Q, false>::call(v);
+			vec<4, float, Q> Result;
+			Result.data = glm_vec4_cos(v.data);
+			return Result;
+		}
+	};
+
+	template<qualifier Q>
+	struct compute_sincos<4, float, Q, true>
+	{
+		GLM_FUNC_QUALIFIER static void call(vec<4, float, Q> const& v, vec<4, float, Q>& s, vec<4, float, Q>& c)
+		{
+			if(!glm_vec4_trig_in_range(v.data))
+			{
+				compute_sincos<4, float, Q, false>::call(v, s, c);
+				return;
+			}
+			glm_vec4_sincos(v.data, &s.data, &c.data);
+		}
+	};
+
+	template<qualifier Q>
+	struct compute_atan2<4, float, Q, true>
+	{
+		GLM_FUNC_QUALIFIER static vec<4, float, Q> call(vec<4, float, Q> const& y, vec<4, float, Q> const& x)
+		{
+			if(!glm_vec4_finite(y.data) || !glm_vec4_finite(x.data))
+				return compute_atan2<4, float, Q, false>::call(y, x);
+			vec<4, float, Q> Result;
+			Result.data = glm_vec4_atan2(y.data, x.data);
+			return Result;
+		}
+	};
+}//namespace detail
+}//namespace glm
+
+#endif//(GLM_ARCH & GLM_ARCH_SSE2_BIT) || (GLM_ARCH & GLM_ARCH_NEON_BIT)
@@ -13,6 +13,7 @@
 #	pragma message("GLM: All extensions included (not recommended)")
 #endif//GLM_MESSAGES
 
+#include "./ext/matrix_batch.hpp"
 #include "./ext/matrix_clip_space.hpp"
 #include "./ext/matrix_common.hpp"
 
@@ -121,6 +122,7 @@
 #include "./ext/vector_integer.hpp"
 #include "./ext/vector_packing.hpp"
 #include "./ext/vector_relational.hpp"
+#include "./ext/vector_trigonometric.hpp"
 #include "./ext/vector_ulp.hpp"
 
 #include "./ext/vector_bool1.hpp"
@@ -0,0 +1,87 @@
+/// @ref ext_matrix_batch
+/// @file glm/ext/matrix_batch.hpp
+///
+/// @defgroup ext_matrix_batch GLM_EXT_matrix_batch
+/// @ingroup ext
+///
+/// Transforms arrays of vectors, stored either as arrays of vectors or as one
+/// array per component, by one matrix or by one matrix per vector. With
+/// GLM_FORCE_INTRINSICS the float 4x4 and 3x3 paths run several vectors per
+/// SSE2, AVX or NEON register.
+///
+/// Include <glm/ext/matrix_batch.hpp> to use the features of this extension.
+///
+/// @see ext_matrix_transform
+
+#pragma once
+
+// Dependencies
+#include "../mat3x3.hpp"
+#include "../mat4x4.hpp"
+#include <cstddef>
+
+#if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
+#	pragma message("GLM: GLM_EXT_matrix_batch extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup ext_matrix_batch
+	/// @{
+
+	/// Writes m * in[i] to out[i] for the count first vectors.
+	/// out may be the same array as in when C == R, but must not partially overlap it.
+	///
+	/// @tparam C Integer between 1 and 4 included that qualify the number of columns of the matrix
+	/// @tparam R Integer between 1 and 4 included that qualify the number of rows of the matrix
+	/// @tparam T Floating-point or signed integer scalar types
+	/// @tparam Q Value from qualifier enum
+	template<length_t C, length_t R, typename T, qualifier Q>
+	GLM_FUNC_DECL void transformBatch(mat<C, R, T, Q> const& m, vec<C, T, Q> const* in, vec<R, T, Q>* out, std::size_t count);
+
+	/// Writes m[i] * in[i] to out[i] for the count first matrices and vectors.
+	/// out may be the same array as in when C == R, but must not partially overlap it.
+	///
+	/// @tparam C Integer between 1 and 4 included that qualify the number of columns of the matrix
+	/// @tparam R Integer between 1 and 4 included that qualify the number of rows of the matrix
+	/// @tparam T Floating-point or signed integer scalar types
+	/// @tparam Q Value from qualifier enum
+	template<length_t C, length_t R, typename T, qualifier Q>
+	GLM_FUNC_DECL void transformBatch(mat<C, R, T, Q> const* m, vec<C, T, Q> const* in, vec<R, T, Q>* out, std::size_t count);
+
+	/// Transforms the count first points of in by the affine matrix m, as if
+	/// each had a last coordinate of one, and writes them to out without the
+	/// perspective divide. out may be the same array as in.
+	///
+	/// @tparam L Integer between 2 and 4 included that qualify the dimension of the matrix
+	/// @tparam T Floating-point or signed integer scalar types
+	/// @tparam Q Value from qualifier enum
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_DECL void transformPointBatch(mat<L, L, T, Q> const& m, vec<L - 1, T, Q> const* in, vec<L - 1, T, Q>* out, std::size_t count);
+
+	/// Transforms the count first points (x[i], y[i], z[i]) by the affine matrix m
+	/// and writes them to (outX[i], outY[i], outZ[i]). Each output array may be the
+	/// same as the matching input array.
+	///
+	/// @tparam T Floating-point or signed integer scalar types
+	/// @tparam Q Value from qualifier enum
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void transformPointBatch(mat<4, 4, T, Q> const& m,
+		T const* x, T const* y, T const* z,
+		T* outX, T* outY, T* outZ, std::size_t count);
+
+	/// Transforms the count first points (x[i], y[i]) by the 2D affine matrix m
+	/// and writes them to (outX[i], outY[i]). Each output array may be the same
+	/// as the matching input array.
+	///
+	/// @tparam T Floating-point or signed integer scalar types
+	/// @tparam Q Value from qualifier enum
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void transformPointBatch(mat<3, 3, T, Q> const& m,
+		T const* x, T const* y,
+		T* outX, T* outY, std::size_t count);
+
+	/// @}
+}//namespace glm
+
+#include "matrix_batch.inl"
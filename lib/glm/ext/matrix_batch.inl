@@ -0,0 +1,114 @@
+namespace glm{
+namespace detail
+{
+	template<length_t C, length_t R, typename T, qualifier Q, bool Aligned>
+	struct compute_transform_batch
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<C, R, T, Q> const& m, vec<C, T, Q> const* in, vec<R, T, Q>* out, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+				out[i] = m * in[i];
+		}
+	};
+
+	template<length_t C, length_t R, typename T, qualifier Q, bool Aligned>
+	struct compute_transform_each
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<C, R, T, Q> const* m, vec<C, T, Q> const* in, vec<R, T, Q>* out, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+				out[i] = m[i] * in[i];
+		}
+	};
+
+	template<length_t L, typename T, qualifier Q, bool Aligned>
+	struct compute_transform_point_batch
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<L, L, T, Q> const& m, vec<L - 1, T, Q> const* in, vec<L - 1, T, Q>* out, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+				out[i] = vec<L - 1, T, Q>(m * vec<L, T, Q>(in[i], static_cast<T>(1)));
+		}
+	};
+
+	template<length_t L, typename T, qualifier Q, bool Aligned>
+	struct compute_transform_point_soa
+	{};
+
+	template<typename T, qualifier Q, bool Aligned>
+	struct compute_transform_point_soa<4, T, Q, Aligned>
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<4, 4, T, Q> const& m,
+			T const* x, T const* y, T const* z,
+			T* outX, T* outY, T* outZ, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				T const px = x[i];
+				T const py = y[i];
+				T const pz = z[i];
+				outX[i] = m[0][0] * px + m[1][0] * py + m[2][0] * pz + m[3][0];
+				outY[i] = m[0][1] * px + m[1][1] * py + m[2][1] * pz + m[3][1];
+				outZ[i] = m[0][2] * px + m[1][2] * py + m[2][2] * pz + m[3][2];
+			}
+		}
+	};
+
+	template<typename T, qualifier Q, bool Aligned>
+	struct compute_transform_point_soa<3, T, Q, Aligned>
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<3, 3, T, Q> const& m,
+			T const* x, T const* y,
+			T* outX, T* outY, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				T const px = x[i];
+				T const py = y[i];
+				outX[i] = m[0][0] * px + m[1][0] * py + m[2][0];
+				outY[i] = m[0][1] * px + m[1][1] * py + m[2][1];
+			}
+		}
+	};
+}//namespace detail
+
+	template<length_t C, length_t R, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void transformBatch(mat<C, R, T, Q> const& m, vec<C, T, Q> const* in, vec<R, T, Q>* out, std::size_t count)
+	{
+		detail::compute_transform_batch<C, R, T, Q, detail::is_aligned<Q>::value>::call(m, in, out, count);
+	}
+
+	template<length_t C, length_t R, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void transformBatch(mat<C, R, T, Q> const* m, vec<C, T, Q> const* in, vec<R, T, Q>* out, std::size_t count)
+	{
+		detail::compute_transform_each<C, R, T, Q, detail::is_aligned<Q>::value>::call(m, in, out, count);
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void transformPointBatch(mat<L, L, T, Q> const& m, vec<L - 1, T, Q> const* in, vec<L - 1, T, Q>* out, std::size_t count)
+	{
+		GLM_STATIC_ASSERT(L >= 2, "'transformPointBatch' needs at least a 2x2 matrix");
+
+		detail::compute_transform_point_batch<L, T, Q, detail::is_aligned<Q>::value>::call(m, in, out, count);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void transformPointBatch(mat<4, 4, T, Q> const& m,
+		T const* x, T const* y, T const* z,
+		T* outX, T* outY, T* outZ, std::size_t count)
+	{
+		detail::compute_transform_point_soa<4, T, Q, detail::is_aligned<Q>::value>::call(m, x, y, z, outX, outY, outZ, count);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void transformPointBatch(mat<3, 3, T, Q> const& m,
+		T const* x, T const* y,
+		T* outX, T* outY, std::size_t count)
+	{
+		detail::compute_transform_point_soa<3, T, Q, detail::is_aligned<Q>::value>::call(m, x, y, outX, outY, count);
+	}
+}//namespace glm
+
+#if GLM_CONFIG_SIMD == GLM_ENABLE
+#	include "matrix_batch_simd.inl"
+#endif
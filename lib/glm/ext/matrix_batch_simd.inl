@@ -0,0 +1,103 @@
+/// @ref ext_matrix_batch
+/// @file glm/ext/matrix_batch_simd.inl
+
+#include "../simd/transform.h"
+
+#if (GLM_ARCH & GLM_ARCH_SSE2_BIT) || (GLM_ARCH & GLM_ARCH_NEON_BIT)
+
+namespace glm{
+namespace detail
+{
+	// The kernels only use unaligned loads and stores, so packed vectors take
+	// them as well. Matrices are copied to tightly packed floats first since
+	// aligned 3 component columns carry a padding float.
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void pack_batch_matrix(mat<4, 4, float, Q> const& m, float p[16])
+	{
+		for(length_t c = 0; c < 4; ++c)
+		for(length_t r = 0; r < 4; ++r)
+			p[c * 4 + r] = m[c][r];
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void pack_batch_matrix(mat<3, 3, float, Q> const& m, float p[9])
+	{
+		for(length_t c = 0; c < 3; ++c)
+		for(length_t r = 0; r < 3; ++r)
+			p[c * 3 + r] = m[c][r];
+	}
+
+	template<qualifier Q, bool Aligned>
+	struct compute_transform_batch<4, 4, float, Q, Aligned>
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<4, 4, float, Q> const& m, vec<4, float, Q> const* in, vec<4, float, Q>* out, std::size_t count)
+		{
+			float p[16];
+			pack_batch_matrix(m, p);
+			glm_mat4_transform_vec4(p, reinterpret_cast<float const*>(in), reinterpret_cast<float*>(out), count);
+		}
+	};
+
+	template<qualifier Q, bool Aligned>
+	struct compute_transform_each<4, 4, float, Q, Aligned>
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<4, 4, float, Q> const* m, vec<4, float, Q> const* in, vec<4, float, Q>* out, std::size_t count)
+		{
+			GLM_STATIC_ASSERT(sizeof(mat<4, 4, float, Q>) == 16 * sizeof(float), "unexpected mat4 layout");
+
+			glm_mat4_transform_each_vec4(reinterpret_cast<float const*>(m), reinterpret_cast<float const*>(in), reinterpret_cast<float*>(out), count);
+		}
+	};
+
+	template<qualifier Q, bool Aligned>
+	struct compute_transform_point_batch<4, float, Q, Aligned>
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<4, 4, float, Q> const& m, vec<3, float, Q> const* in, vec<3, float, Q>* out, std::size_t count)
+		{
+			float p[16];
+			pack_batch_matrix(m, p);
+			glm_mat4_transform_point3(p, reinterpret_cast<float const*>(in), reinterpret_cast<float*>(out), count, sizeof(vec<3, float, Q>) / sizeof(float));
+		}
+	};
+
+	template<qualifier Q, bool Aligned>
+	struct compute_transform_point_batch<3, float, Q, Aligned>
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<3, 3, float, Q> const& m, vec<2, float, Q> const* in, vec<2, float, Q>* out, std::size_t count)
+		{
+			float p[9];
+			pack_batch_matrix(m, p);
+			glm_mat3_transform_point2(p, reinterpret_cast<float const*>(in), reinterpret_cast<float*>(out), count, sizeof(vec<2, float, Q>) / sizeof(float));
+		}
+	};
+
+	template<qualifier Q, bool Aligned>
+	struct compute_transform_point_soa<4, float, Q, Aligned>
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<4, 4, float, Q> const& m,
+			float const* x, float const* y, float const* z,
+			float* outX, float* outY, float* outZ, std::size_t count)
+		{
+			float p[16];
+			pack_batch_matrix(m, p);
+			glm_mat4_transform_point3_soa(p, x, y, z, outX, outY, outZ, count);
+		}
+	};
+
+	template<qualifier Q, bool Aligned>
+	struct compute_transform_point_soa<3, float, Q, Aligned>
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<3, 3, float, Q> const& m,
+			float const* x, float const* y,
+			float* outX, float* outY, std::size_t count)
+		{
+			float p[9];
+			pack_batch_matrix(m, p);
+			glm_mat3_transform_point2_soa(p, x, y, outX, outY, count);
+		}
+	};
+}//namespace detail
+}//namespace glm
+
+#endif//(GLM_ARCH & GLM_ARCH_SSE2_BIT) || (GLM_ARCH & GLM_ARCH_NEON_BIT)
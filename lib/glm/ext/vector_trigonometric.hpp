@@ -0,0 +1,46 @@
+/// @ref ext_vector_trigonometric
+/// @file glm/ext/vector_trigonometric.hpp
+///
+/// @defgroup ext_vector_trigonometric GLM_EXT_vector_trigonometric
+/// @ingroup ext
+///
+/// Sine and cosine of the same angles in one call. With GLM_FORCE_INTRINSICS
+/// and an aligned vec4 of floats, both come out of a single argument
+/// reduction.
+///
+/// Include <glm/ext/vector_trigonometric.hpp> to use the features of this extension.
+///
+/// @see core_func_trigonometric
+
+#pragma once
+
+// Dependencies
+#include "../trigonometric.hpp"
+
+#if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
+#	pragma message("GLM: GLM_EXT_vector_trigonometric extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup ext_vector_trigonometric
+	/// @{
+
+	/// Computes the sine and the cosine of angle.
+	///
+	/// @tparam genType Floating-point scalar types
+	template<typename genType>
+	GLM_FUNC_DECL void sincos(genType angle, genType& s, genType& c);
+
+	/// Computes the sine and the cosine of each component of angle.
+	///
+	/// @tparam L Integer between 1 and 4 included that qualify the dimension of the vector
+	/// @tparam T Floating-point scalar types
+	/// @tparam Q Value from qualifier enum
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_DECL void sincos(vec<L, T, Q> const& angle, vec<L, T, Q>& s, vec<L, T, Q>& c);
+
+	/// @}
+}//namespace glm
+
+#include "vector_trigonometric.inl"
@@ -0,0 +1,19 @@
+namespace glm
+{
+	template<typename genType>
+	GLM_FUNC_QUALIFIER void sincos(genType angle, genType& s, genType& c)
+	{
+		GLM_STATIC_ASSERT(std::numeric_limits<genType>::is_iec559, "'sincos' only accept floating-point inputs");
+
+		s = std::sin(angle);
+		c = std::cos(angle);
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void sincos(vec<L, T, Q> const& angle, vec<L, T, Q>& s, vec<L, T, Q>& c)
+	{
+		GLM_STATIC_ASSERT(std::numeric_limits<T>::is_iec559, "'sincos' only accept floating-point inputs");
+
+		detail::compute_sincos<L, T, Q, detail::is_aligned<Q>::value>::call(angle, s, c);
+	}
+}//namespace glm
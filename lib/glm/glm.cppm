@@ -1871,6 +1871,7 @@ export namespace glm {
 		using glm::packUnorm4x16;
 		using glm::packUnorm4x4;
 		using glm::perlin;
+		using glm::perlinGrid;
 		using glm::perspective;
 		using glm::perspectiveFov;
 		using glm::perspectiveFovLH;
@@ -1889,6 +1890,7 @@ export namespace glm {
 		using glm::perspectiveRH_NO;
 		using glm::perspectiveRH_ZO;
 		using glm::perspectiveZO;
+		using glm::philox4x32;
 		using glm::pi;
 		using glm::pickMatrix;
 		using glm::pitch;
@@ -1925,6 +1927,7 @@ export namespace glm {
 		using glm::sech;
 		using glm::sign;
 		using glm::simplex;
+		using glm::simplexGrid;
 		using glm::sin;
 		using glm::sinh;
 		using glm::slerp;
@@ -2161,6 +2164,7 @@ export namespace glm {
 		using glm::sech;
 		using glm::sign;
 		using glm::sin;
+		using glm::sincos;
 		using glm::sinh;
 		using glm::slerp;
 		using glm::smoothstep;
@@ -2170,6 +2174,8 @@ export namespace glm {
 		using glm::tanh;
 		using glm::third;
 		using glm::three_over_two_pi;
+		using glm::transformBatch;
+		using glm::transformPointBatch;
 		using glm::translate;
 		using glm::transpose;
 		using glm::trunc;
@@ -26,6 +26,7 @@
 #include "../vec2.hpp"
 #include "../vec3.hpp"
 #include "../vec4.hpp"
+#include <cstddef>
 
 #if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
 #	pragma message("GLM: GLM_GTC_noise extension included")
@@ -55,6 +56,54 @@ namespace glm
 	GLM_FUNC_DECL T simplex(
 		vec<L, T, Q> const& p);
 
+	/// Classic perlin noise at count points, written to out.
+	/// Points are evaluated four at a time, one SIMD lane each when aligned
+	/// types are available; results match perlin(p[i]) up to rounding.
+	/// @see gtc_noise
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_DECL void perlin(
+		vec<L, T, Q> const* p,
+		T* out,
+		std::size_t count);
+
+	/// Simplex noise at count points, written to out.
+	/// Points are evaluated four at a time, one SIMD lane each when aligned
+	/// types are available; results match simplex(p[i]) up to rounding.
+	/// @see gtc_noise
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_DECL void simplex(
+		vec<L, T, Q> const* p,
+		T* out,
+		std::size_t count);
+
+	/// Fractal sum of classic perlin noise over a regular grid of size samples.
+	/// Sample index (x, y, ...) sits at origin + (x, y, ...) * spacing and is
+	/// written to out[x + size.x * (y + size.y * ...)]. Octave o samples the
+	/// noise at the position times lacunarity^o and weights it by gain^o.
+	/// Only the rows (runs along the first axis) firstRow to
+	/// firstRow + rowCount - 1 are filled, so threads can share a grid.
+	/// @see gtc_noise
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_DECL void perlinGrid(
+		vec<L, T, Q> const& origin,
+		vec<L, T, Q> const& spacing,
+		vec<L, int, Q> const& size,
+		int octaves, T lacunarity, T gain,
+		std::size_t firstRow, std::size_t rowCount,
+		T* out);
+
+	/// Fractal sum of simplex noise over a regular grid, laid out and split
+	/// into rows like perlinGrid.
+	/// @see gtc_noise
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_DECL void simplexGrid(
+		vec<L, T, Q> const& origin,
+		vec<L, T, Q> const& spacing,
+		vec<L, int, Q> const& size,
+		int octaves, T lacunarity, T gain,
+		std::size_t firstRow, std::size_t rowCount,
+		T* out);
+
 	/// @}
 }//namespace glm
 
@@ -804,4 +804,563 @@ namespace gtc
 			(dot(m0 * m0, vec<3, T, Q>(dot(p0, x0), dot(p1, x1), dot(p2, x2))) +
 			dot(m1 * m1, vec<2, T, Q>(dot(p3, x3), dot(p4, x4))));
 	}
+
+namespace detail
+{
+	// Four points per packet, one packet per coordinate. Each kernel below is
+	// its scalar function above with every scalar turned into a packet and
+	// every vector into a packet per component, in the same order of
+	// operations. Aligned vectors, where available, make each packet
+	// operation one SIMD instruction.
+	template<typename T, qualifier Q>
+	struct noise_packet
+	{
+#		if GLM_CONFIG_ALIGNED_GENTYPES == GLM_ENABLE
+			static qualifier const value = aligned_highp;
+#		else
+			static qualifier const value = Q;
+#		endif
+	};
+
+	template<length_t L, typename T, qualifier Q>
+	struct compute_perlin_x4
+	{};
+
+	template<typename T, qualifier Q>
+	struct compute_perlin_x4<2, T, Q>
+	{
+		typedef vec<4, T, Q> P;
+
+		GLM_FUNC_QUALIFIER static P call(P const* Position)
+		{
+			P const Pfx = fract(Position[0]);
+			P const Pfy = fract(Position[1]);
+			P const Pfz = Pfx - T(1);
+			P const Pfw = Pfy - T(1);
+			P const Pix = mod(floor(Position[0]), P(289));
+			P const Piy = mod(floor(Position[1]), P(289));
+			P const Piz = mod(floor(Position[0]) + T(1), P(289));
+			P const Piw = mod(floor(Position[1]) + T(1), P(289));
+
+			// Corners 00, 10, 01, 11
+			P const px0 = detail::permute(Pix);
+			P const px1 = detail::permute(Piz);
+			P const ix[4] = {px0, px1, px0, px1};
+			P const iy[4] = {Piy, Piy, Piw, Piw};
+			P const fx[4] = {Pfx, Pfz, Pfx, Pfz};
+			P const fy[4] = {Pfy, Pfy, Pfw, Pfw};
+
+			P n[4];
+			for(int c = 0; c < 4; ++c)
+			{
+				P const i = detail::permute(ix[c] + iy[c]);
+				P gx = static_cast<T>(2) * fract(i / T(41)) - T(1);
+				P const gy = abs(gx) - T(0.5);
+				P const tx = floor(gx + T(0.5));
+				gx = gx - tx;
+
+				P const norm = detail::taylorInvSqrt(gx * gx + gy * gy);
+				n[c] = (gx * norm) * fx[c] + (gy * norm) * fy[c];
+			}
+
+			P const fade_x = detail::fade(Pfx);
+			P const fade_y = detail::fade(Pfy);
+			P const n_x0 = mix(n[0], n[1], fade_x);
+			P const n_x1 = mix(n[2], n[3], fade_x);
+			return T(2.3) * mix(n_x0, n_x1, fade_y);
+		}
+	};
+
+	template<typename T, qualifier Q>
+	struct compute_perlin_x4<3, T, Q>
+	{
+		typedef vec<4, T, Q> P;
+
+		GLM_FUNC_QUALIFIER static P call(P const* Position)
+		{
+			P Pi0[3], Pi1[3], Pf0[3], Pf1[3];
+			for(int d = 0; d < 3; ++d)
+			{
+				Pi0[d] = floor(Position[d]);
+				Pi1[d] = detail::mod289(Pi0[d] + T(1));
+				Pi0[d] = detail::mod289(Pi0[d]);
+				Pf0[d] = fract(Position[d]);
+				Pf1[d] = Pf0[d] - T(1);
+			}
+
+			// Corners 00, 10, 01, 11 in x and y, then z = 0 and z = 1
+			P const px0 = detail::permute(Pi0[0]);
+			P const px1 = detail::permute(Pi1[0]);
+			P const ix[4] = {px0, px1, px0, px1};
+			P const iy[4] = {Pi0[1], Pi0[1], Pi1[1], Pi1[1]};
+			P const fx[4] = {Pf0[0], Pf1[0], Pf0[0], Pf1[0]};
+			P const fy[4] = {Pf0[1], Pf0[1], Pf1[1], Pf1[1]};
+			P const fz[2] = {Pf0[2], Pf1[2]};
+			P const iz[2] = {Pi0[2], Pi1[2]};
+
+			P n[2][4];
+			for(int c = 0; c < 4; ++c)
+			{
+				P const ixy = detail::permute(ix[c] + iy[c]);
+				for(int z = 0; z < 2; ++z)
+				{
+					P gx = detail::permute(ixy + iz[z]) * T(1.0 / 7.0);
+					P gy = fract(floor(gx) * T(1.0 / 7.0)) - T(0.5);
+					gx = fract(gx);
+					P const gz = P(0.5) - abs(gx) - abs(gy);
+					P const sz = step(gz, P(0.0));
+					gx -= sz * (step(T(0), gx) - T(0.5));
+					gy -= sz * (step(T(0), gy) - T(0.5));
+
+					P const norm = detail::taylorInvSqrt(gx * gx + gy * gy + gz * gz);
+					n[z][c] = (gx * norm) * fx[c] + (gy * norm) * fy[c] + (gz * norm) * fz[z];
+				}
+			}
+
+			P const fade_x = detail::fade(Pf0[0]);
+			P const fade_y = detail::fade(Pf0[1]);
+			P const fade_z = detail::fade(Pf0[2]);
+			P n_z[4];
+			for(int c = 0; c < 4; ++c)
+				n_z[c] = mix(n[0][c], n[1][c], fade_z);
+			P const n_yz0 = mix(n_z[0], n_z[2], fade_y);
+			P const n_yz1 = mix(n_z[1], n_z[3], fade_y);
+			return T(2.2) * mix(n_yz0, n_yz1, fade_x);
+		}
+	};
+
+	template<typename T, qualifier Q>
+	struct compute_perlin_x4<4, T, Q>
+	{
+		typedef vec<4, T, Q> P;
+
+		GLM_FUNC_QUALIFIER static P call(P const* Position)
+		{
+			P Pi0[4], Pi1[4], Pf0[4], Pf1[4];
+			for(int d = 0; d < 4; ++d)
+			{
+				Pi0[d] = floor(Position[d]);
+				Pi1[d] = mod(Pi0[d] + T(1), P(289));
+				Pi0[d] = mod(Pi0[d], P(289));
+				Pf0[d] = fract(Position[d]);
+				Pf1[d] = Pf0[d] - T(1);
+			}
+
+			// Corners 00, 10, 01, 11 in x and y, then zw = 00, 01, 10, 11
+			P const px0 = detail::permute(Pi0[0]);
+			P const px1 = detail::permute(Pi1[0]);
+			P const ix[4] = {px0, px1, px0, px1};
+			P const iy[4] = {Pi0[1], Pi0[1], Pi1[1], Pi1[1]};
+			P const fx[4] = {Pf0[0], Pf1[0], Pf0[0], Pf1[0]};
+			P const fy[4] = {Pf0[1], Pf0[1], Pf1[1], Pf1[1]};
+			P const iz[2] = {Pi0[2], Pi1[2]};
+			P const iw[2] = {Pi0[3], Pi1[3]};
+			P const fz[2] = {Pf0[2], Pf1[2]};
+			P const fw[2] = {Pf0[3], Pf1[3]};
+
+			P n[2][2][4];
+			for(int c = 0; c < 4; ++c)
+			{
+				P const ixy = detail::permute(ix[c] + iy[c]);
+				for(int z = 0; z < 2; ++z)
+				{
+					P const ixyz = detail::permute(ixy + iz[z]);
+					for(int w = 0; w < 2; ++w)
+					{
+						P gx = detail::permute(ixyz + iw[w]) / T(7);
+						P gy = floor(gx) / T(7);
+						P gz = floor(gy) / T(6);
+						gx = fract(gx) - T(0.5);
+						gy = fract(gy) - T(0.5);
+						gz = fract(gz) - T(0.5);
+						P const gw = P(0.75) - abs(gx) - abs(gy) - abs(gz);
+						P const sw = step(gw, P(0.0));
+						gx -= sw * (step(T(0), gx) - T(0.5));
+						gy -= sw * (step(T(0), gy) - T(0.5));
+
+						P const norm = detail::taylorInvSqrt((gx * gx + gy * gy) + (gz * gz + gw * gw));
+						n[z][w][c] =
+							((gx * norm) * fx[c] + (gy * norm) * fy[c]) +
+							((gz * norm) * fz[z] + (gw * norm) * fw[w]);
+					}
+				}
+			}
+
+			P const fade_x = detail::fade(Pf0[0]);
+			P const fade_y = detail::fade(Pf0[1]);
+			P const fade_z = detail::fade(Pf0[2]);
+			P const fade_w = detail::fade(Pf0[3]);
+			P n_zw[4];
+			for(int c = 0; c < 4; ++c)
+			{
+				P const n_0w = mix(n[0][0][c], n[0][1][c], fade_w);
+				P const n_1w = mix(n[1][0][c], n[1][1][c], fade_w);
+				n_zw[c] = mix(n_0w, n_1w, fade_z);
+			}
+			P const n_yzw0 = mix(n_zw[0], n_zw[2], fade_y);
+			P const n_yzw1 = mix(n_zw[1], n_zw[3], fade_y);
+			return T(2.2) * mix(n_yzw0, n_yzw1, fade_x);
+		}
+	};
+
+	template<length_t L, typename T, qualifier Q>
+	struct compute_simplex_x4
+	{};
+
+	template<typename T, qualifier Q>
+	struct compute_simplex_x4<2, T, Q>
+	{
+		typedef vec<4, T, Q> P;
+
+		GLM_FUNC_QUALIFIER static P call(P const* v)
+		{
+			vec<4, T, Q> const C = vec<4, T, Q>(
+				T( 0.211324865405187),  // (3.0 -  sqrt(3.0)) / 6.0
+				T( 0.366025403784439),  //  0.5 * (sqrt(3.0)  - 1.0)
+				T(-0.577350269189626),	// -1.0 + 2.0 * C.x
+				T( 0.024390243902439)); //  1.0 / 41.0
+
+			// First corner
+			P const s = v[0] * C[1] + v[1] * C[1];
+			P ix = floor(v[0] + s);
+			P iy = floor(v[1] + s);
+			P const t = ix * C[0] + iy * C[0];
+			P const x0x = v[0] - ix + t;
+			P const x0y = v[1] - iy + t;
+
+			// Other corners
+			P const i1x = T(1) - step(x0x, x0y); // x0x > x0y ? 1 : 0
+			P const i1y = T(1) - i1x;
+			P const x12[4] = {x0x + C.x - i1x, x0y + C.x - i1y, x0x + C.z, x0y + C.z};
+
+			// Permutations
+			ix = mod(ix, P(289));
+			iy = mod(iy, P(289));
+			P const p[3] = {
+				detail::permute(detail::permute(iy + T(0)) + ix + T(0)),
+				detail::permute(detail::permute(iy + i1y) + ix + i1x),
+				detail::permute(detail::permute(iy + T(1)) + ix + T(1))};
+
+			P m[3] = {
+				max(P(0.5) - (x0x * x0x + x0y * x0y), P(0)),
+				max(P(0.5) - (x12[0] * x12[0] + x12[1] * x12[1]), P(0)),
+				max(P(0.5) - (x12[2] * x12[2] + x12[3] * x12[3]), P(0))};
+
+			// Gradients: 41 points uniformly over a line, mapped onto a diamond.
+			P const px[3] = {x0x, x12[0], x12[2]};
+			P const py[3] = {x0y, x12[1], x12[3]};
+			P Result(0);
+			for(int k = 0; k < 3; ++k)
+			{
+				m[k] = m[k] * m[k];
+				m[k] = m[k] * m[k];
+
+				P const x = static_cast<T>(2) * fract(p[k] * C.w) - T(1);
+				P const h = abs(x) - T(0.5);
+				P const ox = floor(x + T(0.5));
+				P const a0 = x - ox;
+
+				m[k] *= static_cast<T>(1.79284291400159) - T(0.85373472095314) * (a0 * a0 + h * h);
+				Result = Result + m[k] * (a0 * px[k] + h * py[k]);
+			}
+			return T(130) * Result;
+		}
+	};
+
+	template<typename T, qualifier Q>
+	struct compute_simplex_x4<3, T, Q>
+	{
+		typedef vec<4, T, Q> P;
+
+		GLM_FUNC_QUALIFIER static P call(P const* v)
+		{
+			vec<2, T, Q> const C(1.0 / 6.0, 1.0 / 3.0);
+			vec<4, T, Q> const D(0.0, 0.5, 1.0, 2.0);
+
+			// First corner
+			P const s = v[0] * C.y + v[1] * C.y + v[2] * C.y;
+			P i[3], x0[3];
+			for(int d = 0; d < 3; ++d)
+				i[d] = floor(v[d] + s);
+			P const t = i[0] * C.x + i[1] * C.x + i[2] * C.x;
+			for(int d = 0; d < 3; ++d)
+				x0[d] = v[d] - i[d] + t;
+
+			// Other corners
+			P const g[3] = {step(x0[1], x0[0]), step(x0[2], x0[1]), step(x0[0], x0[2])};
+			P const l[3] = {T(1) - g[0], T(1) - g[1], T(1) - g[2]};
+			P const i1[3] = {min(g[0], l[2]), min(g[1], l[0]), min(g[2], l[1])};
+			P const i2[3] = {max(g[0], l[2]), max(g[1], l[0]), max(g[2], l[1])};
+
+			P x[4][3];
+			for(int d = 0; d < 3; ++d)
+			{
+				x[0][d] = x0[d];
+				x[1][d] = x0[d] - i1[d] + C.x;
+				x[2][d] = x0[d] - i2[d] + C.y;
+				x[3][d] = x0[d] - D.y;
+			}
+
+			// Permutations
+			for(int d = 0; d < 3; ++d)
+				i[d] = detail::mod289(i[d]);
+
+			// Gradients: 7x7 points over a square, mapped onto an octahedron.
+			T n_ = static_cast<T>(0.142857142857); // 1.0/7.0
+			vec<3, T, Q> ns(n_ * vec<3, T, Q>(D.w, D.y, D.z) - vec<3, T, Q>(D.x, D.z, D.x));
+
+			P const o[4][3] = {
+				{P(0), P(0), P(0)},
+				{i1[0], i1[1], i1[2]},
+				{i2[0], i2[1], i2[2]},
+				{P(1), P(1), P(1)}};
+			P m[4], d[4];
+			for(int k = 0; k < 4; ++k)
+			{
+				P const p = detail::permute(detail::permute(detail::permute(
+					i[2] + o[k][2]) +
+					i[1] + o[k][1]) +
+					i[0] + o[k][0]);
+
+				P const j(p - T(49) * floor(p * ns.z * ns.z));  //  mod(p,7*7)
+
+				P const x_(floor(j * ns.z));
+				P const y_(floor(j - T(7) * x_));    // mod(j,N)
+
+				P const gx(x_ * ns.x + ns.y);
+				P const gy(y_ * ns.x + ns.y);
+				P const h(T(1) - abs(gx) - abs(gy));
+
+				P const sh(-step(h, P(0.0)));
+				P const ax = gx + (floor(gx) * T(2) + T(1)) * sh;
+				P const ay = gy + (floor(gy) * T(2) + T(1)) * sh;
+
+				// Normalise gradients
+				P const norm = detail::taylorInvSqrt(ax * ax + ay * ay + h * h);
+				d[k] = (ax * norm) * x[k][0] + (ay * norm) * x[k][1] + (h * norm) * x[k][2];
+
+				m[k] = max(T(0.6) - (x[k][0] * x[k][0] + x[k][1] * x[k][1] + x[k][2] * x[k][2]), P(0));
+				m[k] = m[k] * m[k];
+				m[k] = m[k] * m[k];
+			}
+
+			// Mix final noise value
+			return T(42) * ((m[0] * d[0] + m[1] * d[1]) + (m[2] * d[2] + m[3] * d[3]));
+		}
+	};
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void grad4_x4(vec<4, T, Q> const& j, vec<4, T, Q> const& ip, vec<4, T, Q>* g)
+	{
+		typedef vec<4, T, Q> P;
+
+		P pXYZ[3];
+		for(int d = 0; d < 3; ++d)
+			pXYZ[d] = floor(fract(j * ip[d]) * T(7)) * ip[2] - T(1);
+		P const pW = static_cast<T>(1.5) - (abs(pXYZ[0]) + abs(pXYZ[1]) + abs(pXYZ[2]));
+		P const sW = T(1) - step(T(0), pW); // pW < 0 ? 1 : 0
+		for(int d = 0; d < 3; ++d)
+			g[d] = pXYZ[d] + ((T(1) - step(T(0), pXYZ[d])) * T(2) - T(1)) * sW;
+		g[3] = pW;
+	}
+
+	template<typename T, qualifier Q>
+	struct compute_simplex_x4<4, T, Q>
+	{
+		typedef vec<4, T, Q> P;
+
+		GLM_FUNC_QUALIFIER static P call(P const* v)
+		{
+			vec<4, T, Q> const C(
+				0.138196601125011,  // (5 - sqrt(5))/20  G4
+				0.276393202250021,  // 2 * G4
+				0.414589803375032,  // 3 * G4
+				-0.447213595499958); // -1 + 4 * G4
+
+			// (sqrt(5) - 1)/4 = F4, used once below
+			T const F4 = static_cast<T>(0.309016994374947451);
+
+			// First corner
+			P const s = (v[0] * F4 + v[1] * F4) + (v[2] * F4 + v[3] * F4);
+			P i[4], x0[4];
+			for(int d = 0; d < 4; ++d)
+				i[d] = floor(v[d] + s);
+			P const t = (i[0] * C.x + i[1] * C.x) + (i[2] * C.x + i[3] * C.x);
+			for(int d = 0; d < 4; ++d)
+				x0[d] = v[d] - i[d] + t;
+
+			// Other corners
+
+			// Rank sorting originally contributed by Bill Licea-Kane, AMD (formerly ATI)
+			P const isX[3] = {step(x0[1], x0[0]), step(x0[2], x0[0]), step(x0[3], x0[0])};
+			P const isYZ[3] = {step(x0[2], x0[1]), step(x0[3], x0[1]), step(x0[3], x0[2])};
+			P i0[4] = {isX[0] + isX[1] + isX[2], T(1) - isX[0], T(1) - isX[1], T(1) - isX[2]};
+			i0[1] += isYZ[0] + isYZ[1];
+			i0[2] += static_cast<T>(1) - isYZ[0];
+			i0[3] += static_cast<T>(1) - isYZ[1];
+			i0[2] += isYZ[2];
+			i0[3] += static_cast<T>(1) - isYZ[2];
+
+			// i0 now contains the unique values 0,1,2,3 in each channel
+			P o[5][4];
+			for(int d = 0; d < 4; ++d)
+			{
+				o[0][d] = P(0);
+				o[1][d] = clamp(i0[d] - T(2), T(0), T(1));
+				o[2][d] = clamp(i0[d] - T(1), T(0), T(1));
+				o[3][d] = clamp(i0[d], T(0), T(1));
+				o[4][d] = P(1);
+			}
+
+			P x[5][4];
+			for(int d = 0; d < 4; ++d)
+			{
+				x[0][d] = x0[d];
+				x[1][d] = x0[d] - o[1][d] + C.x;
+				x[2][d] = x0[d] - o[2][d] + C.y;
+				x[3][d] = x0[d] - o[3][d] + C.z;
+				x[4][d] = x0[d] + C.w;
+			}
+
+			// Permutations
+			for(int d = 0; d < 4; ++d)
+				i[d] = mod(i[d], P(289));
+
+			// Gradients: 7x7x6 points over a cube, mapped onto a 4-cross polytope
+			// 7*7*6 = 294, which is close to the ring size 17*17 = 289.
+			vec<4, T, Q> ip = vec<4, T, Q>(T(1) / T(294), T(1) / T(49), T(1) / T(7), T(0));
+
+			P Result0(0), Result1(0);
+			for(int k = 0; k < 5; ++k)
+			{
+				P const j = k == 0
+					? detail::permute(detail::permute(detail::permute(detail::permute(i[3]) + i[2]) + i[1]) + i[0])
+					: detail::permute(detail::permute(detail::permute(detail::permute(
+						i[3] + o[k][3]) +
+						i[2] + o[k][2]) +
+						i[1] + o[k][1]) +
+						i[0] + o[k][0]);
+
+				P g[4];
+				grad4_x4(j, ip, g);
+
+				// Normalise gradients
+				P const norm = detail::taylorInvSqrt((g[0] * g[0] + g[1] * g[1]) + (g[2] * g[2] + g[3] * g[3]));
+				P const d =
+					((g[0] * norm) * x[k][0] + (g[1] * norm) * x[k][1]) +
+					((g[2] * norm) * x[k][2] + (g[3] * norm) * x[k][3]);
+
+				// Mix contributions from the five corners
+				P m = max(T(0.6) - ((x[k][0] * x[k][0] + x[k][1] * x[k][1]) + (x[k][2] * x[k][2] + x[k][3] * x[k][3])), P(0));
+				m = m * m;
+				if(k < 3)
+					Result0 = Result0 + m * m * d;
+				else
+					Result1 = Result1 + m * m * d;
+			}
+			return T(49) * (Result0 + Result1);
+		}
+	};
+
+	template<template<length_t, typename, qualifier> class noise, length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void noise_points(vec<L, T, Q> const* p, T* out, std::size_t count)
+	{
+		typedef vec<4, T, noise_packet<T, Q>::value> packet;
+
+		for(std::size_t i = 0; i < count; i += 4)
+		{
+			std::size_t const n = count - i < 4 ? count - i : 4;
+
+			// A short last packet repeats its last point
+			packet c[L];
+			for(length_t d = 0; d < L; ++d)
+			for(length_t k = 0; k < 4; ++k)
+				c[d][k] = p[i + (static_cast<std::size_t>(k) < n ? static_cast<std::size_t>(k) : n - 1)][d];
+
+			packet const r = noise<L, T, noise_packet<T, Q>::value>::call(c);
+			for(std::size_t k = 0; k < n; ++k)
+				out[i + k] = r[static_cast<length_t>(k)];
+		}
+	}
+
+	template<template<length_t, typename, qualifier> class noise, length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void noise_grid(
+		vec<L, T, Q> const& origin, vec<L, T, Q> const& spacing, vec<L, int, Q> const& size,
+		int octaves, T lacunarity, T gain,
+		std::size_t firstRow, std::size_t rowCount, T* out)
+	{
+		typedef vec<4, T, noise_packet<T, Q>::value> packet;
+
+		assert(octaves > 0);
+		assert(all(greaterThanEqual(size, vec<L, int, Q>(0))));
+
+		std::size_t const width = static_cast<std::size_t>(size.x);
+		for(std::size_t row = firstRow; row < firstRow + rowCount; ++row)
+		{
+			packet base[L];
+			std::size_t rest = row;
+			for(length_t d = 1; d < L; ++d)
+			{
+				std::size_t const index = rest % static_cast<std::size_t>(size[d]);
+				rest /= static_cast<std::size_t>(size[d]);
+				base[d] = packet(origin[d] + static_cast<T>(index) * spacing[d]);
+			}
+
+			T* const line = out + row * width;
+			for(std::size_t x = 0; x < width; x += 4)
+			{
+				std::size_t const n = width - x < 4 ? width - x : 4;
+				base[0] = origin.x + packet(
+					static_cast<T>(x + 0), static_cast<T>(x + 1),
+					static_cast<T>(x + 2), static_cast<T>(x + 3)) * spacing.x;
+
+				packet sum(0);
+				T frequency(1);
+				T amplitude(1);
+				for(int o = 0; o < octaves; ++o)
+				{
+					packet c[L];
+					for(length_t d = 0; d < L; ++d)
+						c[d] = base[d] * frequency;
+					sum += noise<L, T, noise_packet<T, Q>::value>::call(c) * amplitude;
+					frequency *= lacunarity;
+					amplitude *= gain;
+				}
+
+				for(std::size_t k = 0; k < n; ++k)
+					line[x + k] = sum[static_cast<length_t>(k)];
+			}
+		}
+	}
+}//namespace detail
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void perlin(vec<L, T, Q> const* p, T* out, std::size_t count)
+	{
+		detail::noise_points<detail::compute_perlin_x4>(p, out, count);
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void simplex(vec<L, T, Q> const* p, T* out, std::size_t count)
+	{
+		detail::noise_points<detail::compute_simplex_x4>(p, out, count);
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void perlinGrid(
+		vec<L, T, Q> const& origin, vec<L, T, Q> const& spacing, vec<L, int, Q> const& size,
+		int octaves, T lacunarity, T gain,
+		std::size_t firstRow, std::size_t rowCount, T* out)
+	{
+		detail::noise_grid<detail::compute_perlin_x4>(origin, spacing, size, octaves, lacunarity, gain, firstRow, rowCount, out);
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void simplexGrid(
+		vec<L, T, Q> const& origin, vec<L, T, Q> const& spacing, vec<L, int, Q> const& size,
+		int octaves, T lacunarity, T gain,
+		std::size_t firstRow, std::size_t rowCount, T* out)
+	{
+		detail::noise_grid<detail::compute_simplex_x4>(origin, spacing, size, octaves, lacunarity, gain, firstRow, rowCount, out);
+	}
 }//namespace glm
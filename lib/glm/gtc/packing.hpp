@@ -16,6 +16,7 @@
 // Dependency:
 #include "type_precision.hpp"
 #include "../ext/vector_packing.hpp"
+#include <cstddef>
 
 #if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
 #	pragma message("GLM: GLM_GTC_packing extension included")
@@ -512,6 +513,22 @@ namespace glm
 	template<length_t L, qualifier Q>
 	GLM_FUNC_DECL vec<L, float, Q> unpackHalf(vec<L, uint16, Q> const& p);
 
+	/// Converts the Count first floats of In to 16-bit floating-point numbers and writes their bits to Out.
+	/// Values are rounded to nearest even, so exact ties may differ by one unit from packHalf1x16, which rounds them up.
+	/// With GLM_FORCE_INTRINSICS, uses F16C (-mf16c, or AVX2 with Visual C++), SSE2 or NEON instructions.
+	/// Arrays of vectors convert as arrays of floats.
+	///
+	/// @see gtc_packing
+	/// @see void unpackHalf(uint16 const* In, float* Out, std::size_t Count)
+	GLM_FUNC_DECL void packHalf(float const* In, uint16* Out, std::size_t Count);
+
+	/// Converts the Count first 16-bit floating-point numbers of In to 32-bit floating-point values and writes them to Out.
+	/// The conversion is exact.
+	///
+	/// @see gtc_packing
+	/// @see void packHalf(float const* In, uint16* Out, std::size_t Count)
+	GLM_FUNC_DECL void unpackHalf(uint16 const* In, float* Out, std::size_t Count);
+
 	/// Convert each component of the normalized floating-point vector into unsigned integer values.
 	///
 	/// @see gtc_packing
@@ -7,6 +7,7 @@
 #include "../vec3.hpp"
 #include "../vec4.hpp"
 #include "../detail/type_half.hpp"
+#include "../simd/packing.h"
 #include <cstring>
 #include <limits>
 
@@ -350,6 +351,76 @@ namespace detail
 			return vec<4, float, Q>(detail::toFloat32(v.x), detail::toFloat32(v.y), detail::toFloat32(v.z), detail::toFloat32(v.w));
 		}
 	};
+
+	// Same results as glm_f32_to_f16: unlike toFloat16, ties round to even.
+	// After Fabian Giesen's float_to_half_fast3_rtne.
+	GLM_FUNC_QUALIFIER uint16 toHalfRoundEven(float f)
+	{
+		uint32 u;
+		memcpy(&u, &f, sizeof(u));
+		uint32 const Sign = u & 0x80000000u;
+		u ^= Sign;
+
+		uint32 Result;
+		if(u >= static_cast<uint32>((127 + 16) << 23))
+		{
+			// Infinity, or a quiet NaN with the top payload bits
+			Result = u > static_cast<uint32>(255 << 23) ? 0x7e00u | ((u >> 13) & 0x3ffu) : 0x7c00u;
+		}
+		else if(u < static_cast<uint32>(113 << 23))
+		{
+			// Subnormal or zero: the float add does the rounding
+			uint32 const MagicBits = static_cast<uint32>(((127 - 15) + (23 - 10) + 1) << 23);
+			float Magic;
+			memcpy(&Magic, &MagicBits, sizeof(Magic));
+
+			float Abs;
+			memcpy(&Abs, &u, sizeof(Abs));
+			Abs += Magic;
+			memcpy(&Result, &Abs, sizeof(Result));
+			Result -= MagicBits;
+		}
+		else
+		{
+			// Rebias the exponent and round the 13 dropped bits to even
+			Result = (u - (static_cast<uint32>(127 - 15) << 23) + 0xfffu + ((u >> 13) & 1u)) >> 13;
+		}
+
+		return static_cast<uint16>(Result | (Sign >> 16));
+	}
+
+	// Same results as glm_f16_to_f32. Unlike toFloat32, signaling NaNs come back quiet.
+	GLM_FUNC_QUALIFIER float fromHalf(uint16 h)
+	{
+		uint32 u = static_cast<uint32>(h & 0x7fffu) << 13;
+		uint32 const Exponent = u & (0x7c00u << 13);
+		u += static_cast<uint32>(127 - 15) << 23;
+
+		float Result;
+		if(Exponent == (0x7c00u << 13))
+		{
+			// Infinity or quiet NaN
+			u += static_cast<uint32>(128 - 16) << 23;
+			if(u & 0x007fffffu)
+				u |= 0x00400000u;
+			memcpy(&Result, &u, sizeof(Result));
+		}
+		else if(Exponent == 0)
+		{
+			// Zero or subnormal: renormalize
+			u += 1u << 23;
+			memcpy(&Result, &u, sizeof(Result));
+			Result -= 6.103515625e-05f; // 2^-14
+		}
+		else
+			memcpy(&Result, &u, sizeof(Result));
+
+		uint32 Bits;
+		memcpy(&Bits, &Result, sizeof(Bits));
+		Bits |= static_cast<uint32>(h & 0x8000u) << 16;
+		memcpy(&Result, &Bits, sizeof(Result));
+		return Result;
+	}
 }//namespace detail
 
 	GLM_FUNC_QUALIFIER uint8 packUnorm1x8(float v)
@@ -668,6 +739,28 @@ namespace detail
 		return detail::compute_half<L, Q>::unpack(v);
 	}
 
+	GLM_FUNC_QUALIFIER void packHalf(float const* In, uint16* Out, std::size_t Count)
+	{
+#		if GLM_CONFIG_SIMD == GLM_ENABLE && GLM_SIMD_HALF == GLM_ENABLE
+			GLM_STATIC_ASSERT(sizeof(uint16) == sizeof(unsigned short), "unexpected uint16 size");
+			glm_f32_to_f16(In, reinterpret_cast<unsigned short*>(Out), Count);
+#		else
+			for(std::size_t i = 0; i < Count; ++i)
+				Out[i] = detail::toHalfRoundEven(In[i]);
+#		endif
+	}
+
+	GLM_FUNC_QUALIFIER void unpackHalf(uint16 const* In, float* Out, std::size_t Count)
+	{
+#		if GLM_CONFIG_SIMD == GLM_ENABLE && GLM_SIMD_HALF == GLM_ENABLE
+			GLM_STATIC_ASSERT(sizeof(uint16) == sizeof(unsigned short), "unexpected uint16 size");
+			glm_f16_to_f32(reinterpret_cast<unsigned short const*>(In), Out, Count);
+#		else
+			for(std::size_t i = 0; i < Count; ++i)
+				Out[i] = detail::fromHalf(In[i]);
+#		endif
+	}
+
 	template<typename uintType, length_t L, typename floatType, qualifier Q>
 	GLM_FUNC_QUALIFIER vec<L, uintType, Q> packUnorm(vec<L, floatType, Q> const& v)
 	{
@@ -10,6 +10,11 @@
 /// Include <glm/gtc/random.hpp> to use the features of this extension.
 ///
 /// Generate random number from various distribution methods.
+///
+/// The functions taking a seed draw from a Philox4x32-10 counter-based stream
+/// instead of std::rand(): value i of a stream only depends on the seed and i,
+/// so they are thread-safe, reproducible across platforms and can fill one
+/// buffer in slices from several threads.
 
 #pragma once
 
@@ -17,6 +22,7 @@
 #include "../ext/scalar_int_sized.hpp"
 #include "../ext/scalar_uint_sized.hpp"
 #include "../detail/qualifier.hpp"
+#include <cstddef>
 
 #if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
 #	pragma message("GLM: GLM_GTC_random extension included")
@@ -76,6 +82,44 @@ namespace glm
 	template<typename T>
 	GLM_FUNC_DECL vec<3, T, defaultp> ballRand(T Radius);
 
+	/// Philox4x32-10 bijection: returns four random 32-bit words for a counter and a key.
+	/// The result only depends on the arguments.
+	///
+	/// @see gtc_random
+	GLM_FUNC_DECL vec<4, uint32, defaultp> philox4x32(vec<4, uint32, defaultp> const& Counter, vec<2, uint32, defaultp> const& Key);
+
+	/// Writes values First to First + Count - 1 of the random stream selected by Seed to Out,
+	/// uniformly distributed in [Min, Max).
+	///
+	/// @tparam T Value type. Currently supported: float or double.
+	/// @see gtc_random
+	template<typename T>
+	GLM_FUNC_DECL void linearRand(T Min, T Max, uint64 Seed, uint64 First, T* Out, std::size_t Count);
+
+	/// Writes values First to First + Count - 1 of the random stream selected by Seed to Out,
+	/// according a gaussian distribution of the given mean and standard deviation.
+	///
+	/// @tparam T Value type. Currently supported: float or double.
+	/// @see gtc_random
+	template<typename T>
+	GLM_FUNC_DECL void gaussRand(T Mean, T Deviation, uint64 Seed, uint64 First, T* Out, std::size_t Count);
+
+	/// Writes values First to First + Count - 1 of the random stream selected by Seed to Out,
+	/// regulary distributed within the area of a disk of a given radius.
+	///
+	/// @tparam T Value type. Currently supported: float or double.
+	/// @see gtc_random
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void diskRand(T Radius, uint64 Seed, uint64 First, vec<2, T, Q>* Out, std::size_t Count);
+
+	/// Writes values First to First + Count - 1 of the random stream selected by Seed to Out,
+	/// regulary distributed on a sphere of a given radius.
+	///
+	/// @tparam T Value type. Currently supported: float or double.
+	/// @see gtc_random
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void sphericalRand(T Radius, uint64 Seed, uint64 First, vec<3, T, Q>* Out, std::size_t Count);
+
 	/// @}
 }//namespace glm
 
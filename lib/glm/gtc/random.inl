@@ -2,6 +2,8 @@
 #include "../exponential.hpp"
 #include "../trigonometric.hpp"
 #include "../detail/type_vec1.hpp"
+#include "../ext/vector_trigonometric.hpp"
+#include "../simd/random.h"
 #include <cstdlib>
 #include <ctime>
 #include <cassert>
@@ -300,4 +302,268 @@ namespace detail
 
 		return vec<3, T, defaultp>(x, y, z) * Radius;
 	}
+
+namespace detail
+{
+	GLM_FUNC_QUALIFIER void philox4x32_10(uint32 c[4], uint32 k0, uint32 k1)
+	{
+		for(int round = 0; round < 10; ++round)
+		{
+			uint64 const p0 = static_cast<uint64>(0xD2511F53u) * c[0];
+			uint64 const p1 = static_cast<uint64>(0xCD9E8D57u) * c[2];
+
+			c[0] = static_cast<uint32>(p1 >> 32) ^ c[1] ^ k0;
+			c[1] = static_cast<uint32>(p1);
+			c[2] = static_cast<uint32>(p0 >> 32) ^ c[3] ^ k1;
+			c[3] = static_cast<uint32>(p0);
+
+			k0 += 0x9E3779B9u;
+			k1 += 0xBB67AE85u;
+		}
+	}
+
+	// Word n of the stream keyed by Seed is word n % 4 of the Philox output for
+	// the counter (n / 4, 0, 0, 0). Writes words First to First + Count - 1.
+	GLM_FUNC_QUALIFIER void random_words(uint64 Seed, uint64 First, uint32* Out, std::size_t Count)
+	{
+		uint32 const k0 = static_cast<uint32>(Seed);
+		uint32 const k1 = static_cast<uint32>(Seed >> 32);
+
+		uint32 Words[64];
+		uint64 Block = First >> 2;
+		std::size_t Skip = static_cast<std::size_t>(First & 3);
+
+		while(Count > 0)
+		{
+			// Blocks go four at a time, up to 16 per pass
+			std::size_t Blocks = (Skip + Count + 3) / 4;
+			Blocks = Blocks < 16 ? (Blocks + 3) & ~static_cast<std::size_t>(3) : 16;
+
+			for(std::size_t b = 0; b < Blocks; b += 4)
+			{
+#				if GLM_CONFIG_SIMD == GLM_ENABLE && ((GLM_ARCH & GLM_ARCH_SSE2_BIT) || (GLM_ARCH & GLM_ARCH_NEON_BIT))
+					glm_philox4x32_x4(Block + b, k0, k1, Words + b * 4);
+#				else
+					for(std::size_t j = b; j < b + 4; ++j)
+					{
+						uint32* c = Words + j * 4;
+						c[0] = static_cast<uint32>(Block + j);
+						c[1] = static_cast<uint32>((Block + j) >> 32);
+						c[2] = 0;
+						c[3] = 0;
+						philox4x32_10(c, k0, k1);
+					}
+#				endif
+			}
+
+			std::size_t const n = Count < Blocks * 4 - Skip ? Count : Blocks * 4 - Skip;
+			for(std::size_t i = 0; i < n; ++i)
+				Out[i] = Words[Skip + i];
+
+			Out += n;
+			Count -= n;
+			Block += Blocks;
+			Skip = 0;
+		}
+	}
+
+	template<typename T>
+	struct random_unit
+	{};
+
+	template<>
+	struct random_unit<float>
+	{
+		static std::size_t const words = 1;
+
+		// 24 random bits, [0, 1)
+		GLM_FUNC_QUALIFIER static float call(uint32 const* w)
+		{
+			return static_cast<float>(w[0] >> 8) * 5.9604644775390625e-8f;
+		}
+	};
+
+	template<>
+	struct random_unit<double>
+	{
+		static std::size_t const words = 2;
+
+		// 53 random bits, [0, 1)
+		GLM_FUNC_QUALIFIER static double call(uint32 const* w)
+		{
+			return static_cast<double>((static_cast<uint64>(w[0]) << 21) | (w[1] >> 11)) * 1.1102230246251565404236316680908203125e-16;
+		}
+	};
+
+	// Uniform numbers First to First + Count - 1 in [0, 1) of the stream keyed by Seed
+	template<typename T>
+	GLM_FUNC_QUALIFIER void random_units(uint64 Seed, uint64 First, T* Out, std::size_t Count)
+	{
+		std::size_t const Words = random_unit<T>::words;
+
+		uint32 Buffer[64];
+		for(std::size_t i = 0; i < Count; i += 64 / Words)
+		{
+			std::size_t const n = Count - i < 64 / Words ? Count - i : 64 / Words;
+			random_words(Seed, (First + i) * Words, Buffer, n * Words);
+			for(std::size_t j = 0; j < n; ++j)
+				Out[i + j] = random_unit<T>::call(Buffer + j * Words);
+		}
+	}
+
+	template<typename T>
+	struct random_packet
+	{
+#		if GLM_CONFIG_ALIGNED_GENTYPES == GLM_ENABLE
+			typedef vec<4, T, aligned_highp> type;
+#		else
+			typedef vec<4, T, defaultp> type;
+#		endif
+	};
+
+	// Value i of the distribution streams is made of the uniform numbers 2 * i
+	// and 2 * i + 1. They are handed to Dist four values at a time, in packets
+	// that run on SSE2 or NEON registers when aligned types are enabled.
+	template<typename T, typename genType, typename Dist>
+	GLM_FUNC_QUALIFIER void random_fill2(Dist const& D, uint64 Seed, uint64 First, genType* Out, std::size_t Count)
+	{
+		typedef typename random_packet<T>::type packet;
+
+		T Units[64];
+		for(std::size_t i = 0; i < Count; i += 32)
+		{
+			std::size_t const n = Count - i < 32 ? Count - i : 32;
+			random_units(Seed, (First + i) * 2, Units, n * 2);
+
+			for(std::size_t j = 0; j < n; j += 4)
+			{
+				std::size_t const m = n - j < 4 ? n - j : 4;
+
+				packet u0(static_cast<T>(0));
+				packet u1(static_cast<T>(0));
+				for(std::size_t k = 0; k < m; ++k)
+				{
+					u0[static_cast<length_t>(k)] = Units[(j + k) * 2 + 0];
+					u1[static_cast<length_t>(k)] = Units[(j + k) * 2 + 1];
+				}
+
+				D.call(u0, u1, Out + i + j, m);
+			}
+		}
+	}
+
+	// Box-Muller, cosine branch only so that every value has its own two numbers
+	template<typename T>
+	struct compute_gaussRand_x4
+	{
+		typedef typename random_packet<T>::type packet;
+
+		T Mean;
+		T Deviation;
+
+		GLM_FUNC_QUALIFIER compute_gaussRand_x4(T mean, T deviation) : Mean(mean), Deviation(deviation) {}
+
+		GLM_FUNC_QUALIFIER void call(packet const& u0, packet const& u1, T* Out, std::size_t n) const
+		{
+			// 1 - u0 is in (0, 1], so the log is finite
+			packet const r = sqrt(static_cast<T>(-2) * log(static_cast<T>(1) - u0));
+			packet const g = r * cos(static_cast<T>(6.283185307179586476925286766559) * u1) * Deviation + Mean;
+
+			for(std::size_t k = 0; k < n; ++k)
+				Out[k] = g[static_cast<length_t>(k)];
+		}
+	};
+
+	template<typename T, qualifier Q>
+	struct compute_diskRand_x4
+	{
+		typedef typename random_packet<T>::type packet;
+
+		T Radius;
+
+		GLM_FUNC_QUALIFIER explicit compute_diskRand_x4(T radius) : Radius(radius) {}
+
+		GLM_FUNC_QUALIFIER void call(packet const& u0, packet const& u1, vec<2, T, Q>* Out, std::size_t n) const
+		{
+			packet s, c;
+			sincos(static_cast<T>(6.283185307179586476925286766559) * u1, s, c);
+
+			packet const r = sqrt(u0) * Radius;
+			packet const x = r * c;
+			packet const y = r * s;
+
+			for(std::size_t k = 0; k < n; ++k)
+				Out[k] = vec<2, T, Q>(x[static_cast<length_t>(k)], y[static_cast<length_t>(k)]);
+		}
+	};
+
+	// Archimedes: z is uniform in [-1, 1] on the unit sphere
+	template<typename T, qualifier Q>
+	struct compute_sphericalRand_x4
+	{
+		typedef typename random_packet<T>::type packet;
+
+		T Radius;
+
+		GLM_FUNC_QUALIFIER explicit compute_sphericalRand_x4(T radius) : Radius(radius) {}
+
+		GLM_FUNC_QUALIFIER void call(packet const& u0, packet const& u1, vec<3, T, Q>* Out, std::size_t n) const
+		{
+			packet s, c;
+			sincos(static_cast<T>(6.283185307179586476925286766559) * u1, s, c);
+
+			packet const z = static_cast<T>(1) - static_cast<T>(2) * u0;
+			packet const r = sqrt(max(static_cast<T>(1) - z * z, static_cast<T>(0))) * Radius;
+			packet const x = r * c;
+			packet const y = r * s;
+			packet const w = z * Radius;
+
+			for(std::size_t k = 0; k < n; ++k)
+				Out[k] = vec<3, T, Q>(x[static_cast<length_t>(k)], y[static_cast<length_t>(k)], w[static_cast<length_t>(k)]);
+		}
+	};
+}//namespace detail
+
+	GLM_FUNC_QUALIFIER vec<4, uint32, defaultp> philox4x32(vec<4, uint32, defaultp> const& Counter, vec<2, uint32, defaultp> const& Key)
+	{
+		uint32 c[4] = {Counter.x, Counter.y, Counter.z, Counter.w};
+		detail::philox4x32_10(c, Key.x, Key.y);
+		return vec<4, uint32, defaultp>(c[0], c[1], c[2], c[3]);
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void linearRand(T Min, T Max, uint64 Seed, uint64 First, T* Out, std::size_t Count)
+	{
+		GLM_STATIC_ASSERT(std::numeric_limits<T>::is_iec559, "'linearRand' streams only accept floating-point inputs");
+
+		detail::random_units(Seed, First, Out, Count);
+		for(std::size_t i = 0; i < Count; ++i)
+			Out[i] = Out[i] * (Max - Min) + Min;
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void gaussRand(T Mean, T Deviation, uint64 Seed, uint64 First, T* Out, std::size_t Count)
+	{
+		GLM_STATIC_ASSERT(std::numeric_limits<T>::is_iec559, "'gaussRand' streams only accept floating-point inputs");
+
+		detail::random_fill2<T>(detail::compute_gaussRand_x4<T>(Mean, Deviation), Seed, First, Out, Count);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void diskRand(T Radius, uint64 Seed, uint64 First, vec<2, T, Q>* Out, std::size_t Count)
+	{
+		GLM_STATIC_ASSERT(std::numeric_limits<T>::is_iec559, "'diskRand' streams only accept floating-point inputs");
+		assert(Radius > static_cast<T>(0));
+
+		detail::random_fill2<T>(detail::compute_diskRand_x4<T, Q>(Radius), Seed, First, Out, Count);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void sphericalRand(T Radius, uint64 Seed, uint64 First, vec<3, T, Q>* Out, std::size_t Count)
+	{
+		GLM_STATIC_ASSERT(std::numeric_limits<T>::is_iec559, "'sphericalRand' streams only accept floating-point inputs");
+		assert(Radius > static_cast<T>(0));
+
+		detail::random_fill2<T>(detail::compute_sphericalRand_x4<T, Q>(Radius), Seed, First, Out, Count);
+	}
 }//namespace glm
@@ -3,6 +3,156 @@
 
 #pragma once
 
+#include "platform.h"
+#include <cstddef>
+#include <cstring>
+
+// Bulk conversions between float and half float bit patterns. Floats are
+// rounded to nearest even and NaNs come out quiet with their sign and top
+// payload bits, as the F16C and NEON instructions do. Tails shorter than a
+// register go through a zero padded copy, so the kernels never read or write
+// past count.
+
 #if GLM_ARCH & GLM_ARCH_SSE2_BIT
 
-#endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+// GCC and Clang need -mf16c (or an -march that has it). Visual C++ has no
+// F16C switch; every AVX2 processor supports it.
+#if (GLM_ARCH & GLM_ARCH_AVX_BIT) && (defined(__F16C__) || ((GLM_COMPILER & GLM_COMPILER_VC) && (GLM_ARCH & GLM_ARCH_AVX2_BIT)))
+#	define GLM_SIMD_F16C GLM_ENABLE
+#else
+#	define GLM_SIMD_F16C GLM_DISABLE
+#endif
+
+#if GLM_SIMD_F16C == GLM_DISABLE
+// Half bits of four floats, one per 32 bit lane, with integer SSE2 after
+// Fabian Giesen's float_to_half_fast3_rtne. Needs denormals to be enabled.
+GLM_FUNC_QUALIFIER glm_uvec4 glm_vec4_to_half(glm_vec4 f)
+{
+	glm_uvec4 const f16max = _mm_set1_epi32((127 + 16) << 23);
+	glm_uvec4 const f32infty = _mm_set1_epi32(255 << 23);
+	glm_uvec4 const minNormal = _mm_set1_epi32(113 << 23);
+	glm_vec4 const denormMagic = _mm_castsi128_ps(_mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23));
+
+	glm_uvec4 const bits = _mm_castps_si128(f);
+	glm_uvec4 const sign = _mm_and_si128(bits, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+	glm_uvec4 const u = _mm_xor_si128(bits, sign);
+
+	// Normal: rebias the exponent and round the 13 dropped bits to even
+	glm_uvec4 const odd = _mm_and_si128(_mm_srli_epi32(u, 13), _mm_set1_epi32(1));
+	glm_uvec4 const normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(u, _mm_set1_epi32(0xfff - ((127 - 15) << 23))), odd), 13);
+
+	// Subnormal or zero: the float add does the rounding
+	glm_uvec4 const subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(u), denormMagic)), _mm_castps_si128(denormMagic));
+
+	// Infinity, or a quiet NaN with the top payload bits
+	glm_uvec4 const isNaN = _mm_cmpgt_epi32(u, f32infty);
+	glm_uvec4 const nan = _mm_or_si128(_mm_set1_epi32(0x7e00), _mm_and_si128(_mm_srli_epi32(u, 13), _mm_set1_epi32(0x3ff)));
+	glm_uvec4 const special = _mm_or_si128(_mm_and_si128(isNaN, nan), _mm_andnot_si128(isNaN, _mm_set1_epi32(0x7c00)));
+
+	glm_uvec4 const isSubnormal = _mm_cmplt_epi32(u, minNormal);
+	glm_uvec4 const isSpecial = _mm_cmpgt_epi32(u, _mm_sub_epi32(f16max, _mm_set1_epi32(1)));
+	glm_uvec4 Result = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+	Result = _mm_or_si128(_mm_and_si128(isSpecial, special), _mm_andnot_si128(isSpecial, Result));
+	return _mm_or_si128(Result, _mm_srli_epi32(sign, 16));
+}
+
+// Floats of four half bit patterns held one per 32 bit lane, after Fabian
+// Giesen's half_to_float_SSE2. Exact, except that NaNs come out quiet.
+GLM_FUNC_QUALIFIER glm_vec4 glm_vec4_from_half(glm_uvec4 h)
+{
+	glm_uvec4 const expmant = _mm_and_si128(h, _mm_set1_epi32(0x7fff));
+	glm_uvec4 const sign = _mm_slli_epi32(_mm_xor_si128(h, expmant), 16);
+
+	// Scaling by 2^112 moves the exponent bias and normalizes subnormals
+	glm_vec4 const scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(expmant, 13)), _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+	glm_uvec4 const infnan = _mm_and_si128(_mm_cmpgt_epi32(expmant, _mm_set1_epi32(0x7bff)), _mm_set1_epi32(255 << 23));
+	glm_uvec4 const quiet = _mm_and_si128(_mm_cmpgt_epi32(expmant, _mm_set1_epi32(0x7c00)), _mm_set1_epi32(0x00400000));
+
+	return _mm_or_ps(scaled, _mm_castsi128_ps(_mm_or_si128(_mm_or_si128(sign, infnan), quiet)));
+}
+#endif//GLM_SIMD_F16C == GLM_DISABLE
+
+// Eight floats to eight halves
+GLM_FUNC_QUALIFIER void glm_f32_to_f16_x8(float const* in, unsigned short* out)
+{
+#	if GLM_SIMD_F16C == GLM_ENABLE
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_cvtps_ph(_mm256_loadu_ps(in), _MM_FROUND_TO_NEAREST_INT));
+#	else
+		// Sign extend so that the saturating pack keeps all 16 bits
+		glm_uvec4 const lo = _mm_srai_epi32(_mm_slli_epi32(glm_vec4_to_half(_mm_loadu_ps(in + 0)), 16), 16);
+		glm_uvec4 const hi = _mm_srai_epi32(_mm_slli_epi32(glm_vec4_to_half(_mm_loadu_ps(in + 4)), 16), 16);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packs_epi32(lo, hi));
+#	endif
+}
+
+// Eight halves to eight floats
+GLM_FUNC_QUALIFIER void glm_f16_to_f32_x8(unsigned short const* in, float* out)
+{
+#	if GLM_SIMD_F16C == GLM_ENABLE
+		_mm256_storeu_ps(out, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(in))));
+#	else
+		glm_uvec4 const h = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in));
+		_mm_storeu_ps(out + 0, glm_vec4_from_half(_mm_unpacklo_epi16(h, _mm_setzero_si128())));
+		_mm_storeu_ps(out + 4, glm_vec4_from_half(_mm_unpackhi_epi16(h, _mm_setzero_si128())));
+#	endif
+}
+
+#	define GLM_SIMD_HALF GLM_ENABLE
+
+#elif (GLM_ARCH & GLM_ARCH_NEON_BIT) && (defined(__aarch64__) || defined(_M_ARM64) || (defined(__ARM_FP) && (__ARM_FP & 2)))
+
+GLM_FUNC_QUALIFIER void glm_f32_to_f16_x8(float const* in, unsigned short* out)
+{
+	vst1_u16(out + 0, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(in + 0))));
+	vst1_u16(out + 4, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(in + 4))));
+}
+
+GLM_FUNC_QUALIFIER void glm_f16_to_f32_x8(unsigned short const* in, float* out)
+{
+	vst1q_f32(out + 0, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(in + 0))));
+	vst1q_f32(out + 4, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(in + 4))));
+}
+
+#	define GLM_SIMD_HALF GLM_ENABLE
+
+#else
+
+#	define GLM_SIMD_HALF GLM_DISABLE
+
+#endif
+
+#if GLM_SIMD_HALF == GLM_ENABLE
+
+GLM_FUNC_QUALIFIER void glm_f32_to_f16(float const* in, unsigned short* out, std::size_t count)
+{
+	std::size_t i = 0;
+	for(; i + 8 <= count; i += 8)
+		glm_f32_to_f16_x8(in + i, out + i);
+
+	if(i < count)
+	{
+		float tmpIn[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+		unsigned short tmpOut[8];
+		std::memcpy(tmpIn, in + i, (count - i) * sizeof(float));
+		glm_f32_to_f16_x8(tmpIn, tmpOut);
+		std::memcpy(out + i, tmpOut, (count - i) * sizeof(unsigned short));
+	}
+}
+
+GLM_FUNC_QUALIFIER void glm_f16_to_f32(unsigned short const* in, float* out, std::size_t count)
+{
+	std::size_t i = 0;
+	for(; i + 8 <= count; i += 8)
+		glm_f16_to_f32_x8(in + i, out + i);
+
+	if(i < count)
+	{
+		unsigned short tmpIn[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+		float tmpOut[8];
+		std::memcpy(tmpIn, in + i, (count - i) * sizeof(unsigned short));
+		glm_f16_to_f32_x8(tmpIn, tmpOut);
+		std::memcpy(out + i, tmpOut, (count - i) * sizeof(float));
+	}
+}
+
+#endif//GLM_SIMD_HALF == GLM_ENABLE
@@ -0,0 +1,118 @@
+/// @ref simd
+/// @file glm/simd/random.h
+
+#pragma once
+
+#include "platform.h"
+
+// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2,
+// 3", SC11) on four counters at once. Lane i of the registers runs the
+// counter (block + i, 0, 0, 0) with key (k0, k1); the 16 output words are
+// stored counter after counter, so out holds the same words as four calls
+// to the scalar glm::philox4x32.
+
+#define GLM_PHILOX_M0 0xD2511F53u
+#define GLM_PHILOX_M1 0xCD9E8D57u
+#define GLM_PHILOX_W0 0x9E3779B9u
+#define GLM_PHILOX_W1 0xBB67AE85u
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+// High and low halves of the 32x32 bit products x * m, per lane
+GLM_FUNC_QUALIFIER void glm_u32vec4_mulhilo(glm_uvec4 x, glm_uvec4 m, glm_uvec4& hi, glm_uvec4& lo)
+{
+	// _mm_mul_epu32 multiplies lanes 0 and 2 into 64 bit products
+	glm_uvec4 const even = _mm_shuffle_epi32(_mm_mul_epu32(x, m), _MM_SHUFFLE(3, 1, 2, 0));
+	glm_uvec4 const odd = _mm_shuffle_epi32(_mm_mul_epu32(_mm_srli_epi64(x, 32), m), _MM_SHUFFLE(3, 1, 2, 0));
+	lo = _mm_unpacklo_epi32(even, odd);
+	hi = _mm_unpackhi_epi32(even, odd);
+}
+
+GLM_FUNC_QUALIFIER void glm_philox4x32_x4(unsigned long long block, unsigned int k0, unsigned int k1, unsigned int out[16])
+{
+	glm_uvec4 c0 = _mm_setr_epi32(
+		static_cast<int>(block), static_cast<int>(block + 1),
+		static_cast<int>(block + 2), static_cast<int>(block + 3));
+	glm_uvec4 c1 = _mm_setr_epi32(
+		static_cast<int>(block >> 32), static_cast<int>((block + 1) >> 32),
+		static_cast<int>((block + 2) >> 32), static_cast<int>((block + 3) >> 32));
+	glm_uvec4 c2 = _mm_setzero_si128();
+	glm_uvec4 c3 = _mm_setzero_si128();
+
+	glm_uvec4 const m0 = _mm_set1_epi32(static_cast<int>(GLM_PHILOX_M0));
+	glm_uvec4 const m1 = _mm_set1_epi32(static_cast<int>(GLM_PHILOX_M1));
+
+	for(int round = 0; round < 10; ++round)
+	{
+		glm_uvec4 hi0, lo0, hi1, lo1;
+		glm_u32vec4_mulhilo(c0, m0, hi0, lo0);
+		glm_u32vec4_mulhilo(c2, m1, hi1, lo1);
+
+		c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32(static_cast<int>(k0)));
+		c1 = lo1;
+		c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32(static_cast<int>(k1)));
+		c3 = lo0;
+
+		k0 += GLM_PHILOX_W0;
+		k1 += GLM_PHILOX_W1;
+	}
+
+	// Transpose back to one counter per register
+	glm_uvec4 const t0 = _mm_unpacklo_epi32(c0, c1);
+	glm_uvec4 const t1 = _mm_unpacklo_epi32(c2, c3);
+	glm_uvec4 const t2 = _mm_unpackhi_epi32(c0, c1);
+	glm_uvec4 const t3 = _mm_unpackhi_epi32(c2, c3);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 0), _mm_unpacklo_epi64(t0, t1));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi64(t0, t1));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi64(t2, t3));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi64(t2, t3));
+}
+
+#elif GLM_ARCH & GLM_ARCH_NEON_BIT
+
+GLM_FUNC_QUALIFIER void glm_u32vec4_mulhilo(uint32x4_t x, uint32x2_t m, uint32x4_t& hi, uint32x4_t& lo)
+{
+	uint64x2_t const p01 = vmull_u32(vget_low_u32(x), m);
+	uint64x2_t const p23 = vmull_u32(vget_high_u32(x), m);
+	lo = vcombine_u32(vmovn_u64(p01), vmovn_u64(p23));
+	hi = vcombine_u32(vshrn_n_u64(p01, 32), vshrn_n_u64(p23, 32));
+}
+
+GLM_FUNC_QUALIFIER void glm_philox4x32_x4(unsigned long long block, unsigned int k0, unsigned int k1, unsigned int out[16])
+{
+	unsigned int const lo[4] = {
+		static_cast<unsigned int>(block), static_cast<unsigned int>(block + 1),
+		static_cast<unsigned int>(block + 2), static_cast<unsigned int>(block + 3)};
+	unsigned int const hi[4] = {
+		static_cast<unsigned int>(block >> 32), static_cast<unsigned int>((block + 1) >> 32),
+		static_cast<unsigned int>((block + 2) >> 32), static_cast<unsigned int>((block + 3) >> 32)};
+
+	uint32x4x4_t c;
+	c.val[0] = vld1q_u32(lo);
+	c.val[1] = vld1q_u32(hi);
+	c.val[2] = vdupq_n_u32(0);
+	c.val[3] = vdupq_n_u32(0);
+
+	uint32x2_t const m0 = vdup_n_u32(GLM_PHILOX_M0);
+	uint32x2_t const m1 = vdup_n_u32(GLM_PHILOX_M1);
+
+	for(int round = 0; round < 10; ++round)
+	{
+		uint32x4_t hi0, lo0, hi1, lo1;
+		glm_u32vec4_mulhilo(c.val[0], m0, hi0, lo0);
+		glm_u32vec4_mulhilo(c.val[2], m1, hi1, lo1);
+
+		c.val[0] = veorq_u32(veorq_u32(hi1, c.val[1]), vdupq_n_u32(k0));
+		c.val[1] = lo1;
+		c.val[2] = veorq_u32(veorq_u32(hi0, c.val[3]), vdupq_n_u32(k1));
+		c.val[3] = lo0;
+
+		k0 += GLM_PHILOX_W0;
+		k1 += GLM_PHILOX_W1;
+	}
+
+	// vst4q interleaves the registers back to one counter after the other
+	vst4q_u32(out, c);
+}
+
+#endif//GLM_ARCH & GLM_ARCH_NEON_BIT
@@ -0,0 +1,424 @@
+/// @ref simd
+/// @file glm/simd/transform.h
+
+#pragma once
+
+#include "common.h"
+#include <cstddef>
+
+// Batch transforms of float arrays. Matrices are passed as tightly packed
+// column-major floats (16 for a 4x4, 9 for a 3x3). Array-of-structures
+// kernels take the distance in floats between two vectors so that padded
+// vector types can use them; they only write the components they transform,
+// so out may be the same array as in.
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+GLM_FUNC_QUALIFIER __m256 glm_vec8_fma(__m256 a, __m256 b, __m256 c)
+{
+#	if (GLM_ARCH & GLM_ARCH_AVX2_BIT) && !(GLM_COMPILER & GLM_COMPILER_CLANG)
+		return _mm256_fmadd_ps(a, b, c);
+#	else
+		return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#	endif
+}
+#endif//GLM_ARCH & GLM_ARCH_AVX_BIT
+
+// out[i] = m * in[i] for vec4s
+GLM_FUNC_QUALIFIER void glm_mat4_transform_vec4(float const m[16], float const* in, float* out, std::size_t count)
+{
+	glm_vec4 const c0 = _mm_loadu_ps(m + 0);
+	glm_vec4 const c1 = _mm_loadu_ps(m + 4);
+	glm_vec4 const c2 = _mm_loadu_ps(m + 8);
+	glm_vec4 const c3 = _mm_loadu_ps(m + 12);
+
+	std::size_t i = 0;
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+		__m256 const d0 = _mm256_insertf128_ps(_mm256_castps128_ps256(c0), c0, 1);
+		__m256 const d1 = _mm256_insertf128_ps(_mm256_castps128_ps256(c1), c1, 1);
+		__m256 const d2 = _mm256_insertf128_ps(_mm256_castps128_ps256(c2), c2, 1);
+		__m256 const d3 = _mm256_insertf128_ps(_mm256_castps128_ps256(c3), c3, 1);
+		for(; i + 2 <= count; i += 2)
+		{
+			__m256 const v = _mm256_loadu_ps(in + i * 4);
+			__m256 r = _mm256_mul_ps(d0, _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)));
+			r = glm_vec8_fma(d1, _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+			r = glm_vec8_fma(d2, _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+			r = glm_vec8_fma(d3, _mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3)), r);
+			_mm256_storeu_ps(out + i * 4, r);
+		}
+#	endif
+	for(; i < count; ++i)
+	{
+		glm_vec4 const v = _mm_loadu_ps(in + i * 4);
+		glm_vec4 r = _mm_mul_ps(c0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+		r = glm_vec4_fma(c1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+		r = glm_vec4_fma(c2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+		r = glm_vec4_fma(c3, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r);
+		_mm_storeu_ps(out + i * 4, r);
+	}
+}
+
+// out[i] = m[i] * in[i] for vec4s, m holding count matrices back to back
+GLM_FUNC_QUALIFIER void glm_mat4_transform_each_vec4(float const* m, float const* in, float* out, std::size_t count)
+{
+	for(std::size_t i = 0; i < count; ++i)
+	{
+		float const* const n = m + i * 16;
+		glm_vec4 const v = _mm_loadu_ps(in + i * 4);
+		glm_vec4 r = _mm_mul_ps(_mm_loadu_ps(n + 0), _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+		r = glm_vec4_fma(_mm_loadu_ps(n + 4), _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+		r = glm_vec4_fma(_mm_loadu_ps(n + 8), _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+		r = glm_vec4_fma(_mm_loadu_ps(n + 12), _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r);
+		_mm_storeu_ps(out + i * 4, r);
+	}
+}
+
+// Four points at once, one register per coordinate. s holds the upper 3x4 of
+// the matrix with each entry splatted, column by column.
+GLM_FUNC_QUALIFIER void glm_mat4_transform_point3_x4(glm_vec4 const s[12], glm_vec4 x, glm_vec4 y, glm_vec4 z, glm_vec4* ox, glm_vec4* oy, glm_vec4* oz)
+{
+	*ox = glm_vec4_fma(s[6], z, glm_vec4_fma(s[3], y, glm_vec4_fma(s[0], x, s[9])));
+	*oy = glm_vec4_fma(s[7], z, glm_vec4_fma(s[4], y, glm_vec4_fma(s[1], x, s[10])));
+	*oz = glm_vec4_fma(s[8], z, glm_vec4_fma(s[5], y, glm_vec4_fma(s[2], x, s[11])));
+}
+
+// out[i] = (m * vec4(in[i], 1)).xyz for vec3s stride floats apart
+GLM_FUNC_QUALIFIER void glm_mat4_transform_point3(float const m[16], float const* in, float* out, std::size_t count, std::size_t stride)
+{
+	std::size_t i = 0;
+	if(stride == 3)
+	{
+		glm_vec4 s[12];
+		for(int c = 0; c < 4; ++c)
+		for(int r = 0; r < 3; ++r)
+			s[c * 3 + r] = _mm_set1_ps(m[c * 4 + r]);
+
+		for(; i + 4 <= count; i += 4)
+		{
+			// a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+			glm_vec4 const a = _mm_loadu_ps(in + i * 3 + 0);
+			glm_vec4 const b = _mm_loadu_ps(in + i * 3 + 4);
+			glm_vec4 const c = _mm_loadu_ps(in + i * 3 + 8);
+
+			glm_vec4 const bc0 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+			glm_vec4 const ab0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+			glm_vec4 const bc1 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+			glm_vec4 const ab1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+			glm_vec4 const cc0 = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+			glm_vec4 const x = _mm_shuffle_ps(a, bc0, _MM_SHUFFLE(2, 0, 3, 0));
+			glm_vec4 const y = _mm_shuffle_ps(ab0, bc1, _MM_SHUFFLE(2, 0, 2, 0));
+			glm_vec4 const z = _mm_shuffle_ps(ab1, cc0, _MM_SHUFFLE(2, 0, 2, 0));
+
+			glm_vec4 X, Y, Z;
+			glm_mat4_transform_point3_x4(s, x, y, z, &X, &Y, &Z);
+
+			glm_vec4 const xy0 = _mm_unpacklo_ps(X, Y);
+			glm_vec4 const xy1 = _mm_unpackhi_ps(X, Y);
+			glm_vec4 const zx0 = _mm_shuffle_ps(Z, xy0, _MM_SHUFFLE(2, 2, 0, 0));
+			glm_vec4 const yz0 = _mm_shuffle_ps(xy0, Z, _MM_SHUFFLE(1, 1, 3, 3));
+			glm_vec4 const xz1 = _mm_shuffle_ps(xy1, Z, _MM_SHUFFLE(3, 2, 3, 2));
+			_mm_storeu_ps(out + i * 3 + 0, _mm_shuffle_ps(xy0, zx0, _MM_SHUFFLE(2, 0, 1, 0)));
+			_mm_storeu_ps(out + i * 3 + 4, _mm_shuffle_ps(yz0, xy1, _MM_SHUFFLE(1, 0, 2, 0)));
+			_mm_storeu_ps(out + i * 3 + 8, _mm_shuffle_ps(xz1, xz1, _MM_SHUFFLE(3, 1, 0, 2)));
+		}
+	}
+
+	glm_vec4 const c0 = _mm_loadu_ps(m + 0);
+	glm_vec4 const c1 = _mm_loadu_ps(m + 4);
+	glm_vec4 const c2 = _mm_loadu_ps(m + 8);
+	glm_vec4 const c3 = _mm_loadu_ps(m + 12);
+	for(; i < count; ++i)
+	{
+		float const* const p = in + i * stride;
+		float* const q = out + i * stride;
+		glm_vec4 r = glm_vec4_fma(c0, _mm_load1_ps(p + 0), c3);
+		r = glm_vec4_fma(c1, _mm_load1_ps(p + 1), r);
+		r = glm_vec4_fma(c2, _mm_load1_ps(p + 2), r);
+		_mm_storel_pi(reinterpret_cast<__m64*>(q), r);
+		_mm_store_ss(q + 2, _mm_movehl_ps(r, r));
+	}
+}
+
+// (ox[i], oy[i], oz[i]) = (m * vec4(x[i], y[i], z[i], 1)).xyz
+GLM_FUNC_QUALIFIER void glm_mat4_transform_point3_soa(float const m[16],
+	float const* x, float const* y, float const* z,
+	float* ox, float* oy, float* oz, std::size_t count)
+{
+	std::size_t i = 0;
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+	{
+		__m256 s[12];
+		for(int c = 0; c < 4; ++c)
+		for(int r = 0; r < 3; ++r)
+			s[c * 3 + r] = _mm256_set1_ps(m[c * 4 + r]);
+
+		for(; i + 8 <= count; i += 8)
+		{
+			__m256 const px = _mm256_loadu_ps(x + i);
+			__m256 const py = _mm256_loadu_ps(y + i);
+			__m256 const pz = _mm256_loadu_ps(z + i);
+			_mm256_storeu_ps(ox + i, glm_vec8_fma(s[6], pz, glm_vec8_fma(s[3], py, glm_vec8_fma(s[0], px, s[9]))));
+			_mm256_storeu_ps(oy + i, glm_vec8_fma(s[7], pz, glm_vec8_fma(s[4], py, glm_vec8_fma(s[1], px, s[10]))));
+			_mm256_storeu_ps(oz + i, glm_vec8_fma(s[8], pz, glm_vec8_fma(s[5], py, glm_vec8_fma(s[2], px, s[11]))));
+		}
+	}
+#	endif
+
+	glm_vec4 s[12];
+	for(int c = 0; c < 4; ++c)
+	for(int r = 0; r < 3; ++r)
+		s[c * 3 + r] = _mm_set1_ps(m[c * 4 + r]);
+
+	for(; i + 4 <= count; i += 4)
+	{
+		glm_vec4 X, Y, Z;
+		glm_mat4_transform_point3_x4(s, _mm_loadu_ps(x + i), _mm_loadu_ps(y + i), _mm_loadu_ps(z + i), &X, &Y, &Z);
+		_mm_storeu_ps(ox + i, X);
+		_mm_storeu_ps(oy + i, Y);
+		_mm_storeu_ps(oz + i, Z);
+	}
+	for(; i < count; ++i)
+	{
+		float const px = x[i];
+		float const py = y[i];
+		float const pz = z[i];
+		ox[i] = m[0] * px + m[4] * py + m[8] * pz + m[12];
+		oy[i] = m[1] * px + m[5] * py + m[9] * pz + m[13];
+		oz[i] = m[2] * px + m[6] * py + m[10] * pz + m[14];
+	}
+}
+
+// out[i] = (m * vec3(in[i], 1)).xy for vec2s stride floats apart
+GLM_FUNC_QUALIFIER void glm_mat3_transform_point2(float const m[9], float const* in, float* out, std::size_t count, std::size_t stride)
+{
+	// Two points per register: x0 y0 x1 y1
+	glm_vec4 const c0 = _mm_setr_ps(m[0], m[1], m[0], m[1]);
+	glm_vec4 const c1 = _mm_setr_ps(m[3], m[4], m[3], m[4]);
+	glm_vec4 const c2 = _mm_setr_ps(m[6], m[7], m[6], m[7]);
+
+	std::size_t i = 0;
+	if(stride == 2)
+	{
+		for(; i + 2 <= count; i += 2)
+		{
+			glm_vec4 const v = _mm_loadu_ps(in + i * 2);
+			glm_vec4 r = glm_vec4_fma(c0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0)), c2);
+			r = glm_vec4_fma(c1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1)), r);
+			_mm_storeu_ps(out + i * 2, r);
+		}
+	}
+	for(; i < count; ++i)
+	{
+		float const* const p = in + i * stride;
+		float* const q = out + i * stride;
+		glm_vec4 r = glm_vec4_fma(c0, _mm_load1_ps(p + 0), c2);
+		r = glm_vec4_fma(c1, _mm_load1_ps(p + 1), r);
+		_mm_storel_pi(reinterpret_cast<__m64*>(q), r);
+	}
+}
+
+// (ox[i], oy[i]) = (m * vec3(x[i], y[i], 1)).xy
+GLM_FUNC_QUALIFIER void glm_mat3_transform_point2_soa(float const m[9],
+	float const* x, float const* y,
+	float* ox, float* oy, std::size_t count)
+{
+	std::size_t i = 0;
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+	{
+		__m256 const m00 = _mm256_set1_ps(m[0]), m01 = _mm256_set1_ps(m[1]);
+		__m256 const m10 = _mm256_set1_ps(m[3]), m11 = _mm256_set1_ps(m[4]);
+		__m256 const m20 = _mm256_set1_ps(m[6]), m21 = _mm256_set1_ps(m[7]);
+		for(; i + 8 <= count; i += 8)
+		{
+			__m256 const px = _mm256_loadu_ps(x + i);
+			__m256 const py = _mm256_loadu_ps(y + i);
+			_mm256_storeu_ps(ox + i, glm_vec8_fma(m10, py, glm_vec8_fma(m00, px, m20)));
+			_mm256_storeu_ps(oy + i, glm_vec8_fma(m11, py, glm_vec8_fma(m01, px, m21)));
+		}
+	}
+#	endif
+
+	glm_vec4 const m00 = _mm_set1_ps(m[0]), m01 = _mm_set1_ps(m[1]);
+	glm_vec4 const m10 = _mm_set1_ps(m[3]), m11 = _mm_set1_ps(m[4]);
+	glm_vec4 const m20 = _mm_set1_ps(m[6]), m21 = _mm_set1_ps(m[7]);
+	for(; i + 4 <= count; i += 4)
+	{
+		glm_vec4 const px = _mm_loadu_ps(x + i);
+		glm_vec4 const py = _mm_loadu_ps(y + i);
+		_mm_storeu_ps(ox + i, glm_vec4_fma(m10, py, glm_vec4_fma(m00, px, m20)));
+		_mm_storeu_ps(oy + i, glm_vec4_fma(m11, py, glm_vec4_fma(m01, px, m21)));
+	}
+	for(; i < count; ++i)
+	{
+		float const px = x[i];
+		float const py = y[i];
+		ox[i] = m[0] * px + m[3] * py + m[6];
+		oy[i] = m[1] * px + m[4] * py + m[7];
+	}
+}
+
+#elif GLM_ARCH & GLM_ARCH_NEON_BIT
+
+// out[i] = m * in[i] for vec4s
+GLM_FUNC_QUALIFIER void glm_mat4_transform_vec4(float const m[16], float const* in, float* out, std::size_t count)
+{
+	std::size_t i = 0;
+	for(; i + 4 <= count; i += 4)
+	{
+		float32x4x4_t const v = vld4q_f32(in + i * 4);
+		float32x4x4_t r;
+		for(int k = 0; k < 4; ++k)
+		{
+			float32x4_t a = vmulq_n_f32(v.val[0], m[k]);
+			a = vmlaq_n_f32(a, v.val[1], m[4 + k]);
+			a = vmlaq_n_f32(a, v.val[2], m[8 + k]);
+			r.val[k] = vmlaq_n_f32(a, v.val[3], m[12 + k]);
+		}
+		vst4q_f32(out + i * 4, r);
+	}
+
+	float32x4_t const c0 = vld1q_f32(m + 0);
+	float32x4_t const c1 = vld1q_f32(m + 4);
+	float32x4_t const c2 = vld1q_f32(m + 8);
+	float32x4_t const c3 = vld1q_f32(m + 12);
+	for(; i < count; ++i)
+	{
+		float32x4_t const v = vld1q_f32(in + i * 4);
+		float32x4_t r = vmulq_lane_f32(c0, vget_low_f32(v), 0);
+		r = vmlaq_lane_f32(r, c1, vget_low_f32(v), 1);
+		r = vmlaq_lane_f32(r, c2, vget_high_f32(v), 0);
+		r = vmlaq_lane_f32(r, c3, vget_high_f32(v), 1);
+		vst1q_f32(out + i * 4, r);
+	}
+}
+
+// out[i] = m[i] * in[i] for vec4s, m holding count matrices back to back
+GLM_FUNC_QUALIFIER void glm_mat4_transform_each_vec4(float const* m, float const* in, float* out, std::size_t count)
+{
+	for(std::size_t i = 0; i < count; ++i)
+	{
+		float const* const n = m + i * 16;
+		float32x4_t const v = vld1q_f32(in + i * 4);
+		float32x4_t r = vmulq_lane_f32(vld1q_f32(n + 0), vget_low_f32(v), 0);
+		r = vmlaq_lane_f32(r, vld1q_f32(n + 4), vget_low_f32(v), 1);
+		r = vmlaq_lane_f32(r, vld1q_f32(n + 8), vget_high_f32(v), 0);
+		r = vmlaq_lane_f32(r, vld1q_f32(n + 12), vget_high_f32(v), 1);
+		vst1q_f32(out + i * 4, r);
+	}
+}
+
+// Four points at once, one register per coordinate
+GLM_FUNC_QUALIFIER void glm_mat4_transform_point3_x4(float const m[16], float32x4_t x, float32x4_t y, float32x4_t z, float32x4_t* ox, float32x4_t* oy, float32x4_t* oz)
+{
+	*ox = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(m[12]), x, m[0]), y, m[4]), z, m[8]);
+	*oy = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(m[13]), x, m[1]), y, m[5]), z, m[9]);
+	*oz = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(m[14]), x, m[2]), y, m[6]), z, m[10]);
+}
+
+// out[i] = (m * vec4(in[i], 1)).xyz for vec3s stride floats apart
+GLM_FUNC_QUALIFIER void glm_mat4_transform_point3(float const m[16], float const* in, float* out, std::size_t count, std::size_t stride)
+{
+	std::size_t i = 0;
+	if(stride == 3)
+	{
+		for(; i + 4 <= count; i += 4)
+		{
+			float32x4x3_t const v = vld3q_f32(in + i * 3);
+			float32x4x3_t r;
+			glm_mat4_transform_point3_x4(m, v.val[0], v.val[1], v.val[2], &r.val[0], &r.val[1], &r.val[2]);
+			vst3q_f32(out + i * 3, r);
+		}
+	}
+
+	float32x4_t const c0 = vld1q_f32(m + 0);
+	float32x4_t const c1 = vld1q_f32(m + 4);
+	float32x4_t const c2 = vld1q_f32(m + 8);
+	float32x4_t const c3 = vld1q_f32(m + 12);
+	for(; i < count; ++i)
+	{
+		float const* const p = in + i * stride;
+		float* const q = out + i * stride;
+		float32x4_t r = vmlaq_n_f32(c3, c0, p[0]);
+		r = vmlaq_n_f32(r, c1, p[1]);
+		r = vmlaq_n_f32(r, c2, p[2]);
+		vst1_f32(q, vget_low_f32(r));
+		vst1q_lane_f32(q + 2, r, 2);
+	}
+}
+
+// (ox[i], oy[i], oz[i]) = (m * vec4(x[i], y[i], z[i], 1)).xyz
+GLM_FUNC_QUALIFIER void glm_mat4_transform_point3_soa(float const m[16],
+	float const* x, float const* y, float const* z,
+	float* ox, float* oy, float* oz, std::size_t count)
+{
+	std::size_t i = 0;
+	for(; i + 4 <= count; i += 4)
+	{
+		float32x4_t X, Y, Z;
+		glm_mat4_transform_point3_x4(m, vld1q_f32(x + i), vld1q_f32(y + i), vld1q_f32(z + i), &X, &Y, &Z);
+		vst1q_f32(ox + i, X);
+		vst1q_f32(oy + i, Y);
+		vst1q_f32(oz + i, Z);
+	}
+	for(; i < count; ++i)
+	{
+		float const px = x[i];
+		float const py = y[i];
+		float const pz = z[i];
+		ox[i] = m[0] * px + m[4] * py + m[8] * pz + m[12];
+		oy[i] = m[1] * px + m[5] * py + m[9] * pz + m[13];
+		oz[i] = m[2] * px + m[6] * py + m[10] * pz + m[14];
+	}
+}
+
+// out[i] = (m * vec3(in[i], 1)).xy for vec2s stride floats apart
+GLM_FUNC_QUALIFIER void glm_mat3_transform_point2(float const m[9], float const* in, float* out, std::size_t count, std::size_t stride)
+{
+	std::size_t i = 0;
+	if(stride == 2)
+	{
+		for(; i + 4 <= count; i += 4)
+		{
+			float32x4x2_t const v = vld2q_f32(in + i * 2);
+			float32x4x2_t r;
+			r.val[0] = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(m[6]), v.val[0], m[0]), v.val[1], m[3]);
+			r.val[1] = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(m[7]), v.val[0], m[1]), v.val[1], m[4]);
+			vst2q_f32(out + i * 2, r);
+		}
+	}
+
+	float32x2_t const c0 = vld1_f32(m + 0);
+	float32x2_t const c1 = vld1_f32(m + 3);
+	float32x2_t const c2 = vld1_f32(m + 6);
+	for(; i < count; ++i)
+	{
+		float const* const p = in + i * stride;
+		vst1_f32(out + i * stride, vmla_n_f32(vmla_n_f32(c2, c0, p[0]), c1, p[1]));
+	}
+}
+
+// (ox[i], oy[i]) = (m * vec3(x[i], y[i], 1)).xy
+GLM_FUNC_QUALIFIER void glm_mat3_transform_point2_soa(float const m[9],
+	float const* x, float const* y,
+	float* ox, float* oy, std::size_t count)
+{
+	std::size_t i = 0;
+	for(; i + 4 <= count; i += 4)
+	{
+		float32x4_t const px = vld1q_f32(x + i);
+		float32x4_t const py = vld1q_f32(y + i);
+		vst1q_f32(ox + i, vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(m[6]), px, m[0]), py, m[3]));
+		vst1q_f32(oy + i, vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(m[7]), px, m[1]), py, m[4]));
+	}
+	for(; i < count; ++i)
+	{
+		float const px = x[i];
+		float const py = y[i];
+		ox[i] = m[0] * px + m[3] * py + m[6];
+		oy[i] = m[1] * px + m[4] * py + m[7];
+	}
+}
+
+#endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
@@ -3,7 +3,252 @@
 
 #pragma once
 
+#include "common.h"
+
+// Single precision sin, cos and atan2 on four lanes, after the Cephes sinf,
+// cosf and atanf kernels. Errors below were measured against double
+// precision libm, with and without FMA, and are in ulp of the exact result.
+// tests/glm_trig_libm.cpp runs the sweeps and asserts these bounds.
+//
+// sin/cos: x is reduced by multiples of pi/4 with a three-part Cody-Waite
+// constant, then a degree 7 (sin) or 8 (cos) polynomial runs on
+// [-pi/4, pi/4]. Over every float with |x| <= pi/4: under 1 ulp. Over every
+// float with |x| <= 8192: under 1.6 ulp wherever |result| >= 0.001, and under
+// 8e-8 absolute everywhere (near the zeros of sin and cos the ulp error of a
+// single precision reduction is unbounded). Past 8192 the reduction falls
+// apart; glm_vec4_trig_in_range tells callers when to use libm instead.
+//
+// atan2: the smaller magnitude over the larger is reduced to [0, tan(pi/8)],
+// given to a degree 9 polynomial and moved back to its octant. Over a
+// 4096 x 4096 grid of magnitudes spaced evenly in log2 from 2^-20 to 2^20, in
+// all four quadrants, and 4e8 random pairs: under 2.5 ulp, the worst cases
+// having a ratio just above tan(pi/8). Signed zeros give the same results as
+// std::atan2; infinities and NaN must go to libm (see glm_vec4_finite).
+
+#define GLM_VEC4_TRIG_RANGE 8192.0f
+
 #if GLM_ARCH & GLM_ARCH_SSE2_BIT
 
-#endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+// True when every lane can go through glm_vec4_sincos; false for NaN
+GLM_FUNC_QUALIFIER bool glm_vec4_trig_in_range(glm_vec4 x)
+{
+	glm_vec4 const cmp0 = _mm_cmple_ps(glm_vec4_abs(x), _mm_set1_ps(GLM_VEC4_TRIG_RANGE));
+	return _mm_movemask_ps(cmp0) == 0xF;
+}
+
+// True when no lane is infinite or NaN
+GLM_FUNC_QUALIFIER bool glm_vec4_finite(glm_vec4 x)
+{
+	glm_vec4 const cmp0 = _mm_cmple_ps(glm_vec4_abs(x), _mm_set1_ps(3.402823466e+38f));
+	return _mm_movemask_ps(cmp0) == 0xF;
+}
+
+GLM_FUNC_QUALIFIER void glm_vec4_sincos(glm_vec4 x, glm_vec4* s, glm_vec4* c)
+{
+	glm_vec4 const sgn0 = _mm_castsi128_ps(_mm_set1_epi32(int(0x80000000)));
+	glm_vec4 const abs0 = glm_vec4_abs(x);
+	glm_vec4 sinSign = _mm_and_ps(x, sgn0);
+
+	// Octant, rounded up to even so the remainder lies in [-pi/4, pi/4]
+	glm_ivec4 oct0 = _mm_cvttps_epi32(_mm_mul_ps(abs0, _mm_set1_ps(1.27323954473516f)));
+	oct0 = _mm_and_si128(_mm_add_epi32(oct0, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+	glm_vec4 const oct1 = _mm_cvtepi32_ps(oct0);
+
+	glm_ivec4 const four = _mm_set1_epi32(4);
+	sinSign = _mm_xor_ps(sinSign, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(oct0, four), 29)));
+	glm_vec4 const cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(oct0, _mm_set1_epi32(2)), four), 29));
+	glm_vec4 const useSin = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(oct0, _mm_set1_epi32(2)), _mm_setzero_si128()));
+
+	glm_vec4 r = glm_vec4_fma(oct1, _mm_set1_ps(-0.78515625f), abs0);
+	r = glm_vec4_fma(oct1, _mm_set1_ps(-2.4187564849853515625e-4f), r);
+	r = glm_vec4_fma(oct1, _mm_set1_ps(-3.77489497744594108e-8f), r);
+	glm_vec4 const z = _mm_mul_ps(r, r);
+
+	glm_vec4 pc = glm_vec4_fma(_mm_set1_ps(2.443315711809948e-5f), z, _mm_set1_ps(-1.388731625493765e-3f));
+	pc = glm_vec4_fma(pc, z, _mm_set1_ps(4.166664568298827e-2f));
+	pc = _mm_mul_ps(_mm_mul_ps(pc, z), z);
+	pc = glm_vec4_fma(z, _mm_set1_ps(-0.5f), pc);
+	pc = _mm_add_ps(pc, _mm_set1_ps(1.0f));
+
+	glm_vec4 ps = glm_vec4_fma(_mm_set1_ps(-1.9515295891e-4f), z, _mm_set1_ps(8.3321608736e-3f));
+	ps = glm_vec4_fma(ps, z, _mm_set1_ps(-1.6666654611e-1f));
+	ps = glm_vec4_fma(_mm_mul_ps(ps, z), r, r);
+
+	glm_vec4 const sin0 = _mm_or_ps(_mm_and_ps(useSin, ps), _mm_andnot_ps(useSin, pc));
+	glm_vec4 const cos0 = _mm_or_ps(_mm_and_ps(useSin, pc), _mm_andnot_ps(useSin, ps));
+	*s = _mm_xor_ps(sin0, sinSign);
+	*c = _mm_xor_ps(cos0, cosSign);
+}
+
+GLM_FUNC_QUALIFIER glm_vec4 glm_vec4_sin(glm_vec4 x)
+{
+	glm_vec4 s, c;
+	glm_vec4_sincos(x, &s, &c);
+	return s;
+}
+
+GLM_FUNC_QUALIFIER glm_vec4 glm_vec4_cos(glm_vec4 x)
+{
+	glm_vec4 s, c;
+	glm_vec4_sincos(x, &s, &c);
+	return c;
+}
+
+GLM_FUNC_QUALIFIER glm_vec4 glm_vec4_atan2(glm_vec4 y, glm_vec4 x)
+{
+	glm_vec4 const sgn0 = _mm_castsi128_ps(_mm_set1_epi32(int(0x80000000)));
+	glm_vec4 const ax = glm_vec4_abs(x);
+	glm_vec4 const ay = glm_vec4_abs(y);
+	glm_vec4 const hi = _mm_max_ps(ax, ay);
+	glm_vec4 const lo = _mm_min_ps(ax, ay);
+
+	// Above tan(pi/8), atan(lo / hi) = pi/4 + atan((lo - hi) / (lo + hi)); taking
+	// that straight from lo and hi rounds once instead of twice. 0 / 0 becomes
+	// 0 so both zeros land on an axis.
+	glm_vec4 const big = _mm_cmpgt_ps(lo, _mm_mul_ps(hi, _mm_set1_ps(0.414213562373095f)));
+	glm_vec4 const num = _mm_or_ps(_mm_and_ps(big, _mm_sub_ps(lo, hi)), _mm_andnot_ps(big, lo));
+	glm_vec4 const den = _mm_or_ps(_mm_and_ps(big, _mm_add_ps(lo, hi)), _mm_andnot_ps(big, hi));
+	glm_vec4 const a = _mm_and_ps(_mm_div_ps(num, den), _mm_cmpgt_ps(hi, _mm_setzero_ps()));
+	glm_vec4 const z = _mm_mul_ps(a, a);
+
+	glm_vec4 p = glm_vec4_fma(_mm_set1_ps(8.05374449538e-2f), z, _mm_set1_ps(-1.38776856032e-1f));
+	p = glm_vec4_fma(p, z, _mm_set1_ps(1.99777106478e-1f));
+	p = glm_vec4_fma(p, z, _mm_set1_ps(-3.33329491539e-1f));
+	p = glm_vec4_fma(_mm_mul_ps(p, z), a, a);
+
+	// Octant offsets are added as float head and tail, the tail first
+	p = _mm_add_ps(_mm_add_ps(p, _mm_and_ps(big, _mm_set1_ps(-2.18556941e-8f))), _mm_and_ps(big, _mm_set1_ps(0.785398185f)));
+	glm_vec4 const steep = _mm_cmpgt_ps(ay, ax);
+	glm_vec4 const turn0 = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(-4.37113883e-8f), p), _mm_set1_ps(1.57079637f));
+	p = _mm_or_ps(_mm_and_ps(steep, turn0), _mm_andnot_ps(steep, p));
+	// -0 only counts as left of the y axis when y is zero as well; otherwise
+	// the result is +-pi/2 as it is for +0
+	glm_vec4 const onAxis = _mm_and_ps(_mm_cmpeq_ps(x, _mm_setzero_ps()), _mm_cmpneq_ps(y, _mm_setzero_ps()));
+	glm_vec4 const left = _mm_andnot_ps(onAxis, _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x), 31)));
+	glm_vec4 const turn1 = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(-8.74227766e-8f), p), _mm_set1_ps(3.14159274f));
+	p = _mm_or_ps(_mm_and_ps(left, turn1), _mm_andnot_ps(left, p));
+	return _mm_or_ps(p, _mm_and_ps(y, sgn0));
+}
+
+#elif GLM_ARCH & GLM_ARCH_NEON_BIT
 
+GLM_FUNC_QUALIFIER bool glm_vec4_trig_in_range(glm_f32vec4 x)
+{
+	uint32x4_t const cmp0 = vcleq_f32(vabsq_f32(x), vdupq_n_f32(GLM_VEC4_TRIG_RANGE));
+	uint32x2_t const and0 = vand_u32(vget_low_u32(cmp0), vget_high_u32(cmp0));
+	return (vget_lane_u32(and0, 0) & vget_lane_u32(and0, 1)) == 0xFFFFFFFFu;
+}
+
+GLM_FUNC_QUALIFIER bool glm_vec4_finite(glm_f32vec4 x)
+{
+	uint32x4_t const cmp0 = vcleq_f32(vabsq_f32(x), vdupq_n_f32(3.402823466e+38f));
+	uint32x2_t const and0 = vand_u32(vget_low_u32(cmp0), vget_high_u32(cmp0));
+	return (vget_lane_u32(and0, 0) & vget_lane_u32(and0, 1)) == 0xFFFFFFFFu;
+}
+
+// a * b + c, fused where the target has it
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_trig_fma(glm_f32vec4 a, glm_f32vec4 b, glm_f32vec4 c)
+{
+#	if GLM_ARCH & GLM_ARCH_ARMV8_BIT
+		return vfmaq_f32(c, a, b);
+#	else
+		return vmlaq_f32(c, a, b);
+#	endif
+}
+
+GLM_FUNC_QUALIFIER void glm_vec4_sincos(glm_f32vec4 x, glm_f32vec4* s, glm_f32vec4* c)
+{
+	uint32x4_t const sgn0 = vdupq_n_u32(0x80000000u);
+	glm_f32vec4 const abs0 = vabsq_f32(x);
+	uint32x4_t sinSign = vandq_u32(vreinterpretq_u32_f32(x), sgn0);
+
+	uint32x4_t oct0 = vcvtq_u32_f32(vmulq_f32(abs0, vdupq_n_f32(1.27323954473516f)));
+	oct0 = vandq_u32(vaddq_u32(oct0, vdupq_n_u32(1)), vdupq_n_u32(~1u));
+	glm_f32vec4 const oct1 = vcvtq_f32_u32(oct0);
+
+	uint32x4_t const four = vdupq_n_u32(4);
+	sinSign = veorq_u32(sinSign, vshlq_n_u32(vandq_u32(oct0, four), 29));
+	uint32x4_t const cosSign = vshlq_n_u32(vbicq_u32(four, vsubq_u32(oct0, vdupq_n_u32(2))), 29);
+	uint32x4_t const useSin = vceqq_u32(vandq_u32(oct0, vdupq_n_u32(2)), vdupq_n_u32(0));
+
+	glm_f32vec4 r = glm_vec4_trig_fma(oct1, vdupq_n_f32(-0.78515625f), abs0);
+	r = glm_vec4_trig_fma(oct1, vdupq_n_f32(-2.4187564849853515625e-4f), r);
+	r = glm_vec4_trig_fma(oct1, vdupq_n_f32(-3.77489497744594108e-8f), r);
+	glm_f32vec4 const z = vmulq_f32(r, r);
+
+	glm_f32vec4 pc = glm_vec4_trig_fma(vdupq_n_f32(2.443315711809948e-5f), z, vdupq_n_f32(-1.388731625493765e-3f));
+	pc = glm_vec4_trig_fma(pc, z, vdupq_n_f32(4.166664568298827e-2f));
+	pc = vmulq_f32(vmulq_f32(pc, z), z);
+	pc = glm_vec4_trig_fma(z, vdupq_n_f32(-0.5f), pc);
+	pc = vaddq_f32(pc, vdupq_n_f32(1.0f));
+
+	glm_f32vec4 ps = glm_vec4_trig_fma(vdupq_n_f32(-1.9515295891e-4f), z, vdupq_n_f32(8.3321608736e-3f));
+	ps = glm_vec4_trig_fma(ps, z, vdupq_n_f32(-1.6666654611e-1f));
+	ps = glm_vec4_trig_fma(vmulq_f32(ps, z), r, r);
+
+	glm_f32vec4 const sin0 = vbslq_f32(useSin, ps, pc);
+	glm_f32vec4 const cos0 = vbslq_f32(useSin, pc, ps);
+	*s = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(sin0), sinSign));
+	*c = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(cos0), cosSign));
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_sin(glm_f32vec4 x)
+{
+	glm_f32vec4 s, c;
+	glm_vec4_sincos(x, &s, &c);
+	return s;
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_cos(glm_f32vec4 x)
+{
+	glm_f32vec4 s, c;
+	glm_vec4_sincos(x, &s, &c);
+	return c;
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_atan2(glm_f32vec4 y, glm_f32vec4 x)
+{
+	glm_f32vec4 const ax = vabsq_f32(x);
+	glm_f32vec4 const ay = vabsq_f32(y);
+	glm_f32vec4 const hi = vmaxq_f32(ax, ay);
+	glm_f32vec4 const lo = vminq_f32(ax, ay);
+
+	uint32x4_t const big = vcgtq_f32(lo, vmulq_f32(hi, vdupq_n_f32(0.414213562373095f)));
+	glm_f32vec4 const num = vbslq_f32(big, vsubq_f32(lo, hi), lo);
+	glm_f32vec4 const den = vbslq_f32(big, vaddq_f32(lo, hi), hi);
+
+	// Reciprocal estimates would cost accuracy, so ARMv7 divides lane by lane
+#	if GLM_ARCH & GLM_ARCH_ARMV8_BIT
+		glm_f32vec4 a = vdivq_f32(num, den);
+#	else
+		float num0[4], den0[4];
+		vst1q_f32(num0, num);
+		vst1q_f32(den0, den);
+		for(int i = 0; i < 4; ++i)
+			num0[i] /= den0[i];
+		glm_f32vec4 a = vld1q_f32(num0);
+#	endif
+	a = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vcgtq_f32(hi, vdupq_n_f32(0.0f))));
+	glm_f32vec4 const z = vmulq_f32(a, a);
+
+	glm_f32vec4 p = glm_vec4_trig_fma(vdupq_n_f32(8.05374449538e-2f), z, vdupq_n_f32(-1.38776856032e-1f));
+	p = glm_vec4_trig_fma(p, z, vdupq_n_f32(1.99777106478e-1f));
+	p = glm_vec4_trig_fma(p, z, vdupq_n_f32(-3.33329491539e-1f));
+	p = glm_vec4_trig_fma(vmulq_f32(p, z), a, a);
+
+	// Octant offsets are added as float head and tail, the tail first
+	glm_f32vec4 const zero = vdupq_n_f32(0.0f);
+	p = vaddq_f32(vaddq_f32(p, vbslq_f32(big, vdupq_n_f32(-2.18556941e-8f), zero)), vbslq_f32(big, vdupq_n_f32(0.785398185f), zero));
+	glm_f32vec4 const turn0 = vaddq_f32(vsubq_f32(vdupq_n_f32(-4.37113883e-8f), p), vdupq_n_f32(1.57079637f));
+	p = vbslq_f32(vcgtq_f32(ay, ax), turn0, p);
+	// -0 only counts as left of the y axis when y is zero as well; otherwise
+	// the result is +-pi/2 as it is for +0
+	uint32x4_t const onAxis = vandq_u32(vceqq_f32(x, zero), vmvnq_u32(vceqq_f32(y, zero)));
+	uint32x4_t const left = vbicq_u32(vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_f32(x), 31)), onAxis);
+	glm_f32vec4 const turn1 = vaddq_f32(vsubq_f32(vdupq_n_f32(-8.74227766e-8f), p), vdupq_n_f32(3.14159274f));
+	p = vbslq_f32(left, turn1, p);
+	uint32x4_t const sgn0 = vandq_u32(vreinterpretq_u32_f32(y), vdupq_n_u32(0x80000000u));
+	return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(p), sgn0));
+}
+
+#endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
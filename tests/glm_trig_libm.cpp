@@ -0,0 +1,273 @@
+// Checks the four-lane sin, cos, sincos and atan2 kernels of
+// lib/glm/simd/trigonometric.h against double precision libm, and asserts
+// the error bounds documented at the top of that header. Build it with
+// GLM_FORCE_INTRINSICS (see README.md), with and without
+// GLM_FORCE_DEFAULT_ALIGNED_GENTYPES: it also checks that glm::sin, cos,
+// sincos and atan on vec4 use the kernels exactly when the qualifier is
+// aligned, and fall back to libm for lanes the kernels don't cover.
+//
+//   ./glm_trig_libm [--stride N]
+//
+// --stride N tests every Nth float of the sin/cos sweep and every Nth row of
+// the atan2 grid instead of all of them. Returns 1 when a check fails.
+
+#include <glm/glm.hpp>
+#include <glm/ext/vector_trigonometric.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#if GLM_CONFIG_SIMD != GLM_ENABLE
+#   error "glm_trig_libm needs GLM_FORCE_INTRINSICS on an SSE2 or NEON target"
+#endif
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+typedef glm_vec4 lanes;
+static lanes load(const float* p) { return _mm_loadu_ps(p); }
+static void store(float* p, lanes v) { _mm_storeu_ps(p, v); }
+#elif GLM_ARCH & GLM_ARCH_NEON_BIT
+typedef glm_f32vec4 lanes;
+static lanes load(const float* p) { return vld1q_f32(p); }
+static void store(float* p, lanes v) { vst1q_f32(p, v); }
+#endif
+
+// Whether glm_vec4_fma and glm_vec4_trig_fma fuse
+#if ((GLM_ARCH & GLM_ARCH_AVX2_BIT) && !(GLM_COMPILER & GLM_COMPILER_CLANG)) || (GLM_ARCH & GLM_ARCH_ARMV8_BIT)
+#   define KERNEL_FMA 1
+#else
+#   define KERNEL_FMA 0
+#endif
+
+// Bounds from the header comment of simd/trigonometric.h
+const float TRIG_RANGE = GLM_VEC4_TRIG_RANGE;
+const double SINCOS_ULP_QUARTER_PI = 1.0;   // |x| <= pi/4
+const double SINCOS_ULP = 1.6;              // |x| <= 8192, |result| >= 0.001
+const double SINCOS_ABS = 8e-8;             // |x| <= 8192
+const double ATAN2_ULP = 2.5;
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        std::printf("FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+static unsigned bitsOf(float f) { unsigned u; std::memcpy(&u, &f, sizeof(u)); return u; }
+static float floatOf(unsigned u) { float f; std::memcpy(&f, &u, sizeof(f)); return f; }
+
+// Same bits, or both NaN
+static bool sameFloat(float a, float b) {
+    return bitsOf(a) == bitsOf(b) || (std::isnan(a) && std::isnan(b));
+}
+
+// Error of got in units in the last place of the float closest to exact
+static double ulpError(float got, double exact) {
+    int e;
+    std::frexp(std::fabs(exact), &e);
+    double ulp = std::ldexp(1.0, std::max(e - 24, -149));
+    return std::fabs((double)got - exact) / ulp;
+}
+
+struct ErrorStats {
+    double ulpQuarterPi = 0, ulp = 0, abs = 0;
+    float worstX = 0;
+
+    void add(float x, float got, double exact) {
+        double err = ulpError(got, exact);
+        if (std::fabs(x) <= 0.78539816339744831) ulpQuarterPi = std::max(ulpQuarterPi, err);
+        if (std::fabs(exact) >= 0.001 && err > ulp) { ulp = err; worstX = x; }
+        abs = std::max(abs, std::fabs((double)got - exact));
+    }
+};
+
+static void sweepSinCos(unsigned stride) {
+    ErrorStats sinStats, cosStats, sincosStats;
+    const unsigned last = bitsOf(TRIG_RANGE);
+
+    // Four positive floats and their negatives per step
+    for (unsigned base = 0; base <= last; base += 4 * stride) {
+        float x[8];
+        for (int k = 0; k < 4; ++k) {
+            unsigned u = std::min(base + (unsigned)k * stride, last);
+            x[k] = floatOf(u);
+            x[k + 4] = -x[k];
+        }
+
+        for (int half = 0; half < 2; ++half) {
+            lanes v = load(x + half * 4);
+            float s[4], c[4], s2[4], c2[4];
+            store(s, glm_vec4_sin(v));
+            store(c, glm_vec4_cos(v));
+            lanes vs, vc;
+            glm_vec4_sincos(v, &vs, &vc);
+            store(s2, vs);
+            store(c2, vc);
+
+            for (int k = 0; k < 4; ++k) {
+                float xk = x[half * 4 + k];
+                double es = std::sin((double)xk), ec = std::cos((double)xk);
+                sinStats.add(xk, s[k], es);
+                cosStats.add(xk, c[k], ec);
+                sincosStats.add(xk, s2[k], es);
+                sincosStats.add(xk, c2[k], ec);
+            }
+        }
+    }
+
+    const ErrorStats* all[] = { &sinStats, &cosStats, &sincosStats };
+    const char* names[] = { "sin", "cos", "sincos" };
+    for (int i = 0; i < 3; ++i) {
+        std::printf("%-6s |x|<=pi/4: %.3f ulp  |x|<=%g: %.3f ulp (x = %.9g), %.3g abs\n",
+            names[i], all[i]->ulpQuarterPi, TRIG_RANGE, all[i]->ulp, all[i]->worstX, all[i]->abs);
+        std::string n = names[i];
+        check(all[i]->ulpQuarterPi < SINCOS_ULP_QUARTER_PI, (n + " ulp bound on [-pi/4, pi/4]").c_str());
+        check(all[i]->ulp < SINCOS_ULP, (n + " ulp bound on [-8192, 8192]").c_str());
+        check(all[i]->abs < SINCOS_ABS, (n + " absolute error bound").c_str());
+    }
+}
+
+static void sweepAtan2(unsigned stride) {
+    // 4096 magnitudes from 2^-20 to 2^20; the four lanes are the quadrants
+    const int N = 4096;
+    static float mag[N];
+    for (int i = 0; i < N; ++i) mag[i] = (float)std::exp2(-20.0 + 40.0 * i / (N - 1));
+
+    double worst = 0;
+    float worstY = 0, worstX = 0;
+    for (int i = 0; i < N; i += (int)stride) {
+        for (int j = 0; j < N; ++j) {
+            float y[4] = { mag[i], mag[i], -mag[i], -mag[i] };
+            float x[4] = { mag[j], -mag[j], mag[j], -mag[j] };
+            float r[4];
+            store(r, glm_vec4_atan2(load(y), load(x)));
+            for (int k = 0; k < 4; ++k) {
+                double err = ulpError(r[k], std::atan2((double)y[k], (double)x[k]));
+                if (err > worst) { worst = err; worstY = y[k]; worstX = x[k]; }
+            }
+        }
+    }
+    std::printf("atan2  grid: %.3f ulp (y = %.9g, x = %.9g)\n", worst, worstY, worstX);
+    check(worst < ATAN2_ULP, "atan2 ulp bound on the magnitude grid");
+}
+
+static void signedZeros() {
+    // Every pairing of a signed zero with zeros, finite values and itself
+    const float z = 0.0f, one = 1.0f;
+    const float ys[] = { z, -z, z, -z, z, -z, z, -z, one, -one, one, -one };
+    const float xs[] = { z, z, -z, -z, one, one, -one, -one, z, z, -z, -z };
+    const int count = sizeof(ys) / sizeof(ys[0]);
+
+    for (int i = 0; i < count; i += 4) {
+        float r[4];
+        store(r, glm_vec4_atan2(load(ys + i), load(xs + i)));
+        for (int k = 0; k < 4; ++k) {
+            float e = std::atan2(ys[i + k], xs[i + k]);
+            if (!sameFloat(r[k], e))
+                std::printf("atan2(%g, %g): got %.9g, libm %.9g\n", ys[i + k], xs[i + k], r[k], e);
+            check(sameFloat(r[k], e), "atan2 on signed zeros matches std::atan2");
+        }
+    }
+}
+
+// Vectors with a lane the kernels don't cover give libm's results in every
+// lane; in range, aligned qualifiers give the kernels' and others libm's
+template<glm::qualifier Q>
+static void routing(const char* name) {
+    typedef glm::vec<4, float, Q> vec4q;
+    const bool kernels = glm::detail::is_aligned<Q>::value;
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const std::string n = name;
+
+    const vec4q trig[] = {
+        vec4q(1.0f, std::nextafter(TRIG_RANGE, inf), 2.0f, -3.0f),
+        vec4q(1.0f, 2.0f, nan, 3.0f),
+        vec4q(1e30f, -0.5f, inf, 0.25f) };
+    for (const vec4q& v : trig) {
+        vec4q s = glm::sin(v), c = glm::cos(v), s2, c2;
+        glm::sincos(v, s2, c2);
+        for (int k = 0; k < 4; ++k) {
+            check(sameFloat(s[k], std::sin(v[k])), (n + " sin falls back to libm").c_str());
+            check(sameFloat(c[k], std::cos(v[k])), (n + " cos falls back to libm").c_str());
+            check(sameFloat(s2[k], std::sin(v[k])) && sameFloat(c2[k], std::cos(v[k])), (n + " sincos falls back to libm").c_str());
+        }
+    }
+
+    const vec4q ys(inf, 1.0f, nan, -inf);
+    const vec4q xs(1.0f, inf, 2.0f, -inf);
+    vec4q a = glm::atan(ys, xs);
+    for (int k = 0; k < 4; ++k)
+        check(sameFloat(a[k], std::atan2(ys[k], xs[k])), (n + " atan2 falls back to libm").c_str());
+
+    // Each kernel differs from libm in at least one of these lanes
+    const float in[4] = { 0.5f, -2.0f, 2.5f, -7000.0f };
+    const float inX[4] = { 1.0f, -3.0f, 0.0f, -0.5f };
+    float s[4], c[4], r[4];
+    store(s, glm_vec4_sin(load(in)));
+    store(c, glm_vec4_cos(load(in)));
+    store(r, glm_vec4_atan2(load(in), load(inX)));
+    const vec4q v(in[0], in[1], in[2], in[3]), x(inX[0], inX[1], inX[2], inX[3]);
+    vec4q gs = glm::sin(v), gc = glm::cos(v), ga = glm::atan(v, x), gs2, gc2;
+    glm::sincos(v, gs2, gc2);
+    const std::string route = n + (kernels ? " uses the kernels" : " uses libm");
+    for (int k = 0; k < 4; ++k) {
+        if (!kernels) {
+            s[k] = std::sin(in[k]);
+            c[k] = std::cos(in[k]);
+            r[k] = std::atan2(in[k], inX[k]);
+        }
+        check(sameFloat(gs[k], s[k]) && sameFloat(gc[k], c[k]), (route + " for sin and cos").c_str());
+        check(sameFloat(gs2[k], s[k]) && sameFloat(gc2[k], c[k]), (route + " for sincos").c_str());
+        check(sameFloat(ga[k], r[k]), (route + " for atan2").c_str());
+    }
+}
+
+static void fallback() {
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    float inRange[4] = { TRIG_RANGE, -TRIG_RANGE, 0.0f, 1.0f };
+    float outRange[4] = { 1.0f, std::nextafter(TRIG_RANGE, inf), 2.0f, -3.0f };
+    float withNaN[4] = { 1.0f, 2.0f, nan, 3.0f };
+    float withInf[4] = { 1.0f, -inf, 2.0f, 3.0f };
+    check(glm_vec4_trig_in_range(load(inRange)), "glm_vec4_trig_in_range accepts |x| <= 8192");
+    check(!glm_vec4_trig_in_range(load(outRange)), "glm_vec4_trig_in_range rejects |x| > 8192");
+    check(!glm_vec4_trig_in_range(load(withNaN)), "glm_vec4_trig_in_range rejects NaN");
+    check(glm_vec4_finite(load(inRange)), "glm_vec4_finite accepts finite lanes");
+    check(!glm_vec4_finite(load(withNaN)), "glm_vec4_finite rejects NaN");
+    check(!glm_vec4_finite(load(withInf)), "glm_vec4_finite rejects infinities");
+
+
+    routing<glm::defaultp>("vec4");
+#if GLM_CONFIG_ALIGNED_GENTYPES == GLM_ENABLE
+    routing<glm::aligned_highp>("aligned_highp vec4");
+#endif
+}
+
+int main(int argc, char** argv) {
+    unsigned stride = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--stride") == 0 && i + 1 < argc) stride = (unsigned)std::max(1, std::atoi(argv[++i]));
+        else {
+            std::printf("usage: %s [--stride N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::printf("vec4 aligned: %s, FMA: %s, stride %u\n",
+        glm::detail::is_aligned<glm::defaultp>::value ? "yes" : "no", KERNEL_FMA ? "yes" : "no", stride);
+
+    sweepSinCos(stride);
+    sweepAtan2(stride);
+    signedZeros();
+    fallback();
+
+    std::printf(failures ? "%d check(s) failed\n" : "all checks passed\n", failures);
+    return failures ? 1 : 0;
+}